@@ -0,0 +1,438 @@
+#include "AI.h"
+#include "Evaluate.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/See.h"
+#include <algorithm>
+#include <cstring>
+
+static const int INF = AI::MATE + 1;
+
+// Scores this close to MATE are mates; tablebase mates reach past the search horizon
+static const int MATE_BOUND = AI::MATE - 2 * AI::MAX_SEARCH_PLY;
+
+// Mate scores are stored relative to the node so they stay valid at any ply
+static int scoreToTT(int s, int ply) { return s >= MATE_BOUND ? s + ply : s <= -MATE_BOUND ? s - ply : s; }
+static int scoreFromTT(int s, int ply) { return s >= MATE_BOUND ? s - ply : s <= -MATE_BOUND ? s + ply : s; }
+
+// Tablebase value as a search score at 'ply'
+static int tablebaseScore(const TbResult& r, int ply) {
+    if (r.wdl == TbWdl::DRAW) return 0;
+    int mate = std::min(ply + r.dtm, 2 * AI::MAX_SEARCH_PLY);
+    return r.wdl == TbWdl::WIN ? AI::MATE - mate : -AI::MATE + mate;
+}
+
+static bool isCapture(const Position& pos, Move m) {
+    return m.kind() == MoveKind::EN_PASSANT || (m.kind() != MoveKind::CASTLING && !pos.isEmpty(m.to()));
+}
+
+AI::Worker::Worker() : nodes(0) {
+    reset();
+}
+
+void AI::Worker::reset() {
+    nodes = 0;
+    std::memset(killers, 0, sizeof(killers));
+    std::memset(history, 0, sizeof(history));
+    rootBest = Move();
+}
+
+AI::AI(size_t hashMegabytes, int threads)
+    : tt(hashMegabytes), timeLimitMs(0), pondering(false), stopFlag(false), running(false), finished(false), discardResult(false) {
+    setThreads(threads);
+}
+
+AI::~AI() {
+    cancel();
+}
+
+void AI::setThreads(int threads) {
+    cancel();
+    if (threads < 1) threads = 1;
+    workers.clear();
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(new Worker());
+        workers.back()->id = i;
+    }
+}
+
+int AI::defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 1 ? (int)n - 1 : 1;
+}
+
+int AI::allocateTime(int remainingMs, int incrementMs, int movesToGo) {
+    int share = remainingMs / (movesToGo > 0 ? movesToGo : 30) + incrementMs * 3 / 4;
+    return std::max(1, std::min(share, remainingMs / 2));
+}
+
+void AI::start(const Position& pos, const SearchLimits& limits) {
+    launch(pos, limits, false);
+}
+
+void AI::ponder(const Position& pos, const SearchLimits& limits) {
+    launch(pos, limits, true);
+}
+
+void AI::launch(const Position& pos, const SearchLimits& limits, bool ponderSearch) {
+    cancel();
+    stopFlag = false;
+    finished = false;
+    discardResult = false;
+    startTime = std::chrono::steady_clock::now();
+    timeLimitMs = ponderSearch ? 0 : limits.timeMs;
+    nodeLimit = limits.nodes;
+    pondering = ponderSearch;
+    ponderKey = pos.key();
+    ponderTimeMs = limits.timeMs;
+    running = true;
+    worker = std::thread([this, pos, limits]{
+        SearchResult r = run(pos, limits);
+        { std::lock_guard<std::mutex> lock(resultMutex); lastResult = r; }
+        finished = true;
+    });
+}
+
+void AI::cancel() {
+    stopFlag = true;
+    if (worker.joinable()) worker.join();
+    running = false;
+    finished = false;
+    pondering = false;
+    discardResult = false;
+}
+
+void AI::stop() {
+    pondering = false;
+    stopFlag = true;
+}
+
+void AI::setHashSize(size_t megabytes) {
+    cancel();
+    tt.resize(megabytes);
+}
+
+uint64_t AI::totalNodes() const {
+    uint64_t n = 0;
+    for (auto& w : workers) n += w->nodes.load(std::memory_order_relaxed);
+    return n;
+}
+
+bool AI::ponderHit(const Position& pos) {
+    if (!pondering) return false;
+    if (pos.key() != ponderKey) {
+        // No join here: the thread that polls may be waiting on the worker too
+        discardResult = true;
+        stop();
+        return false;
+    }
+    // The clock has run since pondering began, so a long think by the opponent is
+    // answered as soon as the worker next looks at it
+    timeLimitMs = ponderTimeMs;
+    pondering = false;
+    return true;
+}
+
+bool AI::poll(SearchResult& out) {
+    if (!running || !finished || pondering) return false;
+    worker.join();
+    running = false;
+    finished = false;
+    if (discardResult.exchange(false)) return false;
+    std::lock_guard<std::mutex> lock(resultMutex);
+    out = lastResult;
+    return true;
+}
+
+bool AI::shouldStop(const Worker& w) {
+    // Only the main worker watches the clock and node count; helpers follow the shared flag
+    if (w.id == 0 && (w.nodes.load(std::memory_order_relaxed) & 2047) == 0) {
+        int limit = timeLimitMs;
+        if (limit > 0 && std::chrono::steady_clock::now() - startTime >= std::chrono::milliseconds(limit)) stopFlag = true;
+        if (nodeLimit > 0 && totalNodes() >= nodeLimit) stopFlag = true;
+    }
+    return !w.finishIteration && stopFlag.load(std::memory_order_relaxed);
+}
+
+SearchResult AI::think(const Position& pos, const SearchLimits& limits) {
+    cancel();
+    stopFlag = false;
+    startTime = std::chrono::steady_clock::now();
+    timeLimitMs = limits.timeMs;
+    nodeLimit = limits.nodes;
+    return run(pos, limits);
+}
+
+SearchResult AI::run(const Position& rootPos, const SearchLimits& limits) {
+    SearchResult result;
+    tt.newSearch();
+    for (auto& w : workers) w->reset();
+
+    MoveList rootMoves;
+    MoveGen::generateLegal(rootPos, rootMoves);
+    if (rootMoves.empty()) return result;
+    result.bestMove = rootMoves[0];
+    if (tablebaseMove(rootPos, rootMoves, result)) {
+        principalVariation(rootPos, result.bestMove, 2, result.pv);
+        result.ponderMove = result.pv.size() > 1 ? result.pv[1] : Move();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return result;
+    }
+
+    int maxDepth = limits.maxDepth > 0 ? std::min(limits.maxDepth, MAX_SEARCH_PLY - 1) : MAX_SEARCH_PLY - 1;
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < workers.size(); ++i)
+        helpers.emplace_back([this, i, &rootPos, maxDepth]{ iterate(*workers[i], rootPos, maxDepth, nullptr); });
+    iterate(*workers[0], rootPos, maxDepth, &result);
+
+    // The main thread decides; helpers are stopped as soon as it is done
+    stopFlag = true;
+    for (auto& t : helpers) t.join();
+
+    result.nodes = totalNodes();
+    if (result.pv.empty() || result.pv[0] != result.bestMove) principalVariation(rootPos, result.bestMove, std::max(result.depth, 2), result.pv);
+    result.ponderMove = result.pv.size() > 1 ? result.pv[1] : Move();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+Move AI::expectedReply(const Position& rootPos, Move best) {
+    Position pos = rootPos;
+    pos.makeMove(best);
+    MoveList replies;
+    MoveGen::generateLegal(pos, replies);
+    if (replies.empty()) return Move();
+    SearchResult tb;
+    if (tablebaseMove(pos, replies, tb)) return tb.bestMove;
+    // Stored moves may come from a key collision, so only a legal one is trusted
+    TTEntry e;
+    return tt.probe(pos.key(), e) && replies.contains(e.move) ? e.move : Move();
+}
+
+void AI::principalVariation(const Position& rootPos, Move best, int maxLength, std::vector<Move>& pv) {
+    pv.clear();
+    Position pos = rootPos;
+    std::vector<uint64_t> seen(1, pos.key());
+    for (Move m = best; !m.isNone() && (int)pv.size() < maxLength; ) {
+        pv.push_back(m);
+        Move reply = expectedReply(pos, m);
+        pos.makeMove(m);
+        if (std::find(seen.begin(), seen.end(), pos.key()) != seen.end()) break;
+        seen.push_back(pos.key());
+        m = reply;
+    }
+}
+
+bool AI::tablebaseMove(const Position& rootPos, const MoveList& rootMoves, SearchResult& result) {
+    TbResult r;
+    if (!tablebase || !tablebase->probe(rootPos, r)) return false;
+    // Every child is covered too: captures and minor promotions leave trivially drawn
+    // material, queen and rook promotions land in KQK/KRK. The best child is the opponent's
+    // quickest loss, else a draw, else the slowest win (the longest defence)
+    Position pos = rootPos;
+    int bestScore = -INF;
+    for (const Move& m : rootMoves) {
+        pos.makeMove(m);
+        bool covered = tablebase->probe(pos, r);
+        pos.unmakeMove();
+        if (!covered) return false;
+        int score = -tablebaseScore(r, 1);
+        if (score > bestScore) {
+            bestScore = score;
+            result.bestMove = m;
+        }
+    }
+    result.score = bestScore;
+    result.depth = 1;
+    return true;
+}
+
+void AI::iterate(Worker& w, Position pos, int maxDepth, SearchResult* result) {
+    pos.setAttackTracking(false); // the game's maps would only slow every make/unmake here
+    // Lazy SMP: odd helpers start one ply deeper so threads spread over depths
+    int firstDepth = 1 + (w.id & 1);
+    if (nnue) {
+        nnue->refresh(pos, w.accumulators[0], 0);
+        nnue->refresh(pos, w.accumulators[0], 1);
+    }
+    for (int depth = firstDepth; depth <= maxDepth; ++depth) {
+        w.finishIteration = result && depth == 1;
+        int score = searchNode(w, pos, depth, -INF, INF, 0);
+        w.finishIteration = false;
+        if (!result) {
+            if (stopFlag) return;
+            continue;
+        }
+        // An interrupted iteration is discarded; the previous one stands (depth 1 always completes)
+        if (stopFlag && depth > 1) return;
+        // From this search, not the TT: a helper at another depth may own the root entry now
+        if (!w.rootBest.isNone()) result->bestMove = w.rootBest;
+        result->score = score;
+        result->depth = depth;
+        if (onIteration) {
+            result->nodes = totalNodes();
+            result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            principalVariation(pos, result->bestMove, depth, result->pv);
+            onIteration(*result);
+        }
+        if (stopFlag || score >= MATE - depth || score <= -MATE + depth) return; // forced mate found
+    }
+}
+
+void AI::orderMoves(Worker& w, const Position& pos, const MoveList& moves, Move ttMove, int ply) {
+    int* scores = w.plyScores[ply];
+    int side = pos.whiteToMove() ? 0 : 1;
+    for (int i = 0; i < moves.size(); ++i) {
+        Move m = moves[i];
+        int s;
+        if (m == ttMove) s = 1 << 30;
+        else if (isCapture(pos, m)) {
+            // MVV-LVA: most valuable victim first, cheapest attacker breaks ties; captures that
+            // lose material in the exchange wait until after the killers
+            int victim = m.kind() == MoveKind::EN_PASSANT ? 0 : (int)pos.typeAt(m.to());
+            int mvvLva = Evaluate::PIECE_VALUE[victim] * 16 - Evaluate::PIECE_VALUE[(int)pos.typeAt(m.from())] / 16;
+            s = (See::value(pos, m) < 0 ? 1 << 25 : 1 << 28) + mvvLva;
+        }
+        else if (m.kind() == MoveKind::PROMOTION) s = (1 << 27) + Evaluate::PIECE_VALUE[(int)m.promotion()];
+        else if (m == w.killers[ply][0]) s = (1 << 26) + 1;
+        else if (m == w.killers[ply][1]) s = 1 << 26;
+        else s = w.history[side][m.from()][m.to()];
+        scores[i] = s;
+    }
+}
+
+void AI::makeMove(Worker& w, Position& pos, Move m, int ply) {
+    if (nnue) {
+        Nnue::delta(pos, m, w.deltas[ply + 1]);
+        w.accumulators[ply + 1].computed[0] = w.accumulators[ply + 1].computed[1] = false;
+    }
+    pos.makeMove(m);
+}
+
+int AI::evaluate(Worker& w, const Position& pos, int ply) {
+    if (!nnue) return Evaluate::evaluate(pos);
+    NnueAccumulator* acc = w.accumulators;
+    for (int p = 0; p < 2; ++p) {
+        if (acc[ply].computed[p]) continue;
+        // Back to the nearest ply this perspective is known at; a king move of its own side
+        // on the way makes the whole perspective stale, so it is rebuilt from the board
+        int k = ply;
+        while (!acc[k].computed[p] && !w.deltas[k].kingMoved[p]) --k;
+        if (!acc[k].computed[p]) {
+            nnue->refresh(pos, acc[ply], p);
+            continue;
+        }
+        for (++k; k <= ply; ++k) nnue->update(acc[k - 1], w.deltas[k], pos, acc[k], p);
+    }
+    return nnue->evaluate(pos, acc[ply]);
+}
+
+// Selection step: swap the best-scored remaining move into slot i
+static void pickNext(MoveList& moves, int* scores, int i) {
+    int best = i;
+    for (int j = i + 1; j < moves.size(); ++j) if (scores[j] > scores[best]) best = j;
+    std::swap(moves[i], moves[best]);
+    std::swap(scores[i], scores[best]);
+}
+
+int AI::searchNode(Worker& w, Position& pos, int depth, int alpha, int beta, int ply) {
+    if (shouldStop(w)) return 0;
+    if (ply > 0 && pos.isRepetition()) return 0;
+    if (ply >= MAX_SEARCH_PLY - 1) return evaluate(w, pos, ply);
+
+    TbResult tb;
+    if (ply > 0 && tablebase && tablebase->probe(pos, tb)) { w.countNode(); return tablebaseScore(tb, ply); }
+
+    bool inCheck = MoveGen::checkers(pos) != 0;
+    if (inCheck) ++depth; // check extension
+    if (depth <= 0) return quiesce(w, pos, alpha, beta, ply);
+    w.countNode();
+
+    Move ttMove;
+    TTEntry e;
+    if (tt.probe(pos.key(), e)) {
+        ttMove = e.move;
+        int s = scoreFromTT(e.score, ply);
+        if (ply > 0 && e.depth >= depth) {
+            if (e.bound() == Bound::EXACT) return s;
+            if (e.bound() == Bound::LOWER && s >= beta) return s;
+            if (e.bound() == Bound::UPPER && s <= alpha) return s;
+        }
+    }
+
+    MoveList& moves = w.plyMoves[ply];
+    moves.clear();
+    MoveGen::generateLegal(pos, moves);
+    if (moves.empty()) return inCheck ? -MATE + ply : 0;
+    orderMoves(w, pos, moves, ttMove, ply);
+
+    int origAlpha = alpha, best = -INF;
+    Move bestMove;
+    for (int i = 0; i < moves.size(); ++i) {
+        pickNext(moves, w.plyScores[ply], i);
+        Move m = moves[i];
+        bool quiet = !isCapture(pos, m) && m.kind() != MoveKind::PROMOTION;
+        makeMove(w, pos, m, ply);
+        int score = -searchNode(w, pos, depth - 1, -beta, -alpha, ply + 1);
+        pos.unmakeMove();
+        if (stopFlag && !w.finishIteration) return 0;
+
+        if (score > best) {
+            best = score;
+            bestMove = m;
+            if (score > alpha) alpha = score;
+        }
+        if (alpha >= beta) {
+            if (quiet) {
+                if (w.killers[ply][0] != m) { w.killers[ply][1] = w.killers[ply][0]; w.killers[ply][0] = m; }
+                w.history[pos.whiteToMove() ? 0 : 1][m.from()][m.to()] += depth * depth;
+            }
+            break;
+        }
+    }
+    if (ply == 0) w.rootBest = bestMove;
+    Bound bound = best >= beta ? Bound::LOWER : best > origAlpha ? Bound::EXACT : Bound::UPPER;
+    tt.store(pos.key(), bestMove, scoreToTT(best, ply), 0, depth, bound);
+    return best;
+}
+
+int AI::quiesce(Worker& w, Position& pos, int alpha, int beta, int ply) {
+    if (shouldStop(w)) return 0;
+    w.countNode();
+    bool inCheck = MoveGen::checkers(pos) != 0;
+    if (ply >= MAX_SEARCH_PLY - 1) return evaluate(w, pos, ply);
+
+    // Stand pat: the side to move may decline every capture (not while in check)
+    if (!inCheck) {
+        int standPat = evaluate(w, pos, ply);
+        if (standPat >= beta) return standPat;
+        if (standPat > alpha) alpha = standPat;
+    }
+
+    MoveList& moves = w.plyMoves[ply];
+    moves.clear();
+    MoveGen::generateLegal(pos, moves);
+    if (moves.empty()) return inCheck ? -MATE + ply : 0;
+    if (!inCheck) {
+        // Keep captures and queen promotions that do not lose material by exchange (SEE
+        // pruning); walk backwards so removeAt never skips an entry
+        for (int i = moves.size() - 1; i >= 0; --i) {
+            Move m = moves[i];
+            bool tactical = isCapture(pos, m) || (m.kind() == MoveKind::PROMOTION && m.promotion() == PieceType::QUEEN);
+            if (!tactical || See::value(pos, m) < 0) moves.removeAt(i);
+        }
+    }
+    orderMoves(w, pos, moves, Move(), ply);
+
+    int best = inCheck ? -INF : alpha;
+    for (int i = 0; i < moves.size(); ++i) {
+        pickNext(moves, w.plyScores[ply], i);
+        makeMove(w, pos, moves[i], ply);
+        int score = -quiesce(w, pos, -beta, -alpha, ply + 1);
+        pos.unmakeMove();
+        if (stopFlag && !w.finishIteration) return 0;
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    return best;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Feature/basic/GameLogic/MoveList.h"
+#include "Feature/basic/GameLogic/Position.h"
+#include "Feature/basic/GameLogic/Tablebase.h"
+#include "Feature/basic/GameLogic/TranspositionTable.h"
+#include "Feature/advanced/Nnue/Nnue.h"
+
+// Search limits; a zero value means "no limit" for that dimension
+struct SearchLimits {
+    int maxDepth = 0;
+    int timeMs = 0;
+    uint64_t nodes = 0;   // checked every 2048 nodes of the main thread, so it may overshoot
+};
+
+struct SearchResult {
+    Move bestMove;        // none if the side to move has no legal move
+    Move ponderMove;      // expected reply to bestMove, if known
+    std::vector<Move> pv; // principal variation from the transposition table, bestMove first
+    int score = 0;        // centipawns from the mover's point of view
+    int depth = 0;        // last fully completed iteration
+    uint64_t nodes = 0;   // summed over all search threads
+    double seconds = 0.0;
+};
+
+// Iterative-deepening alpha-beta engine. start() searches a copy of the position
+// on a worker thread so the caller (the render loop) only polls for the result.
+// With more than one thread it runs Lazy SMP: helper threads search the same root
+// with staggered depths and share work only through the lock-free transposition table.
+// While the opponent thinks, ponder() searches the position after their expected reply;
+// the tree it builds stays in the transposition table for the real search.
+class AI {
+public:
+    static const int MATE = 32000;
+    static const int MAX_SEARCH_PLY = 96;
+
+    explicit AI(size_t hashMegabytes = 16, int threads = 1);
+    ~AI();
+    AI(const AI&) = delete;
+    AI& operator=(const AI&) = delete;
+
+    // Number of search threads (main + helpers); takes effect on the next search
+    void setThreads(int threads);
+    int threadCount() const { return (int)workers.size(); }
+    // All cores but one, leaving room for the render thread
+    static int defaultThreadCount();
+    // Time for one move under a clock: an even share of what is left (over movesToGo moves,
+    // or 30 when unknown) plus most of the increment, never more than half the remaining time
+    static int allocateTime(int remainingMs, int incrementMs, int movesToGo = 0);
+
+    // Asynchronous search; any search still running is cancelled first
+    void start(const Position& pos, const SearchLimits& limits);
+    // Stop the worker and drop its result
+    void cancel();
+    bool isThinking() const { return running; }
+    // End the running search (or ponder search) early; poll() still delivers its result.
+    // Only sets flags, so any thread may call it
+    void stop();
+    // Returns true exactly once per finished search, filling 'out'; never while pondering,
+    // nor for a ponder search ended by a missed ponderHit (isThinking() then turns false)
+    bool poll(SearchResult& out);
+
+    // Asynchronous search of 'pos', the position after the opponent's expected reply; the
+    // time limit in 'limits' only takes effect at ponderHit()
+    void ponder(const Position& pos, const SearchLimits& limits);
+    bool isPondering() const { return pondering; }
+    // Call once the opponent has moved: true if 'pos' is the pondered position, which turns
+    // the ponder search into a normal one (time already spent counts towards the limit);
+    // otherwise the ponder search is stopped and its result dropped. Only sets flags, like stop()
+    bool ponderHit(const Position& pos);
+
+    // Blocking search on the calling thread
+    SearchResult think(const Position& pos, const SearchLimits& limits);
+    // Forget everything learned in earlier searches
+    void clearHash() { tt.clear(); }
+    // Reallocate the transposition table (cancels any running search)
+    void setHashSize(size_t megabytes);
+    // Permille of the transposition table filled by the current search
+    int hashfull() const { return tt.hashfull(); }
+    // Called on the search thread after every completed iteration of start() and think()
+    // with the running totals and PV; set it while no search runs
+    void setInfoCallback(std::function<void(const SearchResult&)> callback) { onIteration = std::move(callback); }
+    // Endgame tables probed at the root and inside the tree (nullptr disables); must
+    // outlive the engine and not be regenerated while a search runs
+    void setTablebase(const Tablebase* tb) { tablebase = tb; }
+    // Neural evaluation in place of the hand-written one (nullptr restores it); same
+    // lifetime rules as the tablebase
+    void setNnue(const Nnue* net) { nnue = net; }
+
+private:
+    // Per-thread search state; nothing here is shared between threads
+    struct Worker {
+        int id = 0;
+        // Written by its own thread only; atomic so totals can be read during the search
+        std::atomic<uint64_t> nodes;
+        Move killers[MAX_SEARCH_PLY][2];
+        int history[2][64][64];
+        MoveList plyMoves[MAX_SEARCH_PLY + 1];
+        int plyScores[MAX_SEARCH_PLY + 1][MoveList::CAPACITY];
+        // Network accumulators per ply and the feature changes of the move into each ply
+        NnueAccumulator accumulators[MAX_SEARCH_PLY + 1];
+        NnueDelta deltas[MAX_SEARCH_PLY + 1];
+        // Best move of this worker's last completed root search (helpers share the TT entry)
+        Move rootBest;
+        // Set on the main worker during its depth-1 pass, which runs to the end even after a
+        // stop so there is always a searched move to play
+        bool finishIteration = false;
+        Worker();
+        void reset();
+        void countNode() { nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    };
+
+    void launch(const Position& pos, const SearchLimits& limits, bool ponderSearch);
+    SearchResult run(const Position& rootPos, const SearchLimits& limits);
+    // Legal reply to 'best' from the tables or the transposition table; none if unknown
+    Move expectedReply(const Position& rootPos, Move best);
+    // Chain of expected replies from 'best', at most maxLength moves, stopping at a repetition
+    void principalVariation(const Position& rootPos, Move best, int maxLength, std::vector<Move>& pv);
+    uint64_t totalNodes() const;
+    // One thread's iterative deepening; only the main worker fills 'result'
+    void iterate(Worker& w, Position pos, int maxDepth, SearchResult* result);
+    int searchNode(Worker& w, Position& pos, int depth, int alpha, int beta, int ply);
+    int quiesce(Worker& w, Position& pos, int alpha, int beta, int ply);
+    // Fill w.plyScores[ply] with ordering keys; the search loop then picks moves lazily
+    void orderMoves(Worker& w, const Position& pos, const MoveList& moves, Move ttMove, int ply);
+    bool shouldStop(const Worker& w);
+    // Make m at 'ply', recording what the network needs to update the child lazily
+    void makeMove(Worker& w, Position& pos, Move m, int ply);
+    int evaluate(Worker& w, const Position& pos, int ply);
+    // Root move straight from the tables; false if the root is not covered
+    bool tablebaseMove(const Position& rootPos, const MoveList& rootMoves, SearchResult& result);
+
+    TranspositionTable tt;
+    const Tablebase* tablebase = nullptr;
+    const Nnue* nnue = nullptr;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Set before the worker starts; only the limit changes while it runs (ponderHit)
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<int> timeLimitMs;
+    uint64_t nodeLimit = 0;
+    std::function<void(const SearchResult&)> onIteration;
+    std::atomic<bool> pondering;
+    uint64_t ponderKey = 0;
+    int ponderTimeMs = 0;
+
+    std::thread worker;
+    std::atomic<bool> stopFlag;
+    std::atomic<bool> running;
+    std::atomic<bool> finished;
+    std::atomic<bool> discardResult;
+    std::mutex resultMutex;
+    SearchResult lastResult;
+};
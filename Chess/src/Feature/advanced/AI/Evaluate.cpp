@@ -0,0 +1,162 @@
+#include "Evaluate.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EVALUATE_SSE2 1
+#endif
+
+const int Evaluate::PIECE_VALUE[6] = { 100, 500, 320, 330, 900, 0 };
+
+bool Evaluate::useSimd = Evaluate::simdSupported();
+
+// Per safe square attacked (not held by an own piece nor hit by an enemy pawn)
+static const Score KNIGHT_MOBILITY = makeScore(4, 4);
+static const Score DIAGONAL_MOBILITY = makeScore(5, 5);   // bishops and queens
+static const Score ORTHOGONAL_MOBILITY = makeScore(2, 4); // rooks and queens
+// Per pawn
+static const Score DOUBLED_PAWN = makeScore(-10, -20);
+static const Score ISOLATED_PAWN = makeScore(-10, -15);
+static const Score PASSED_PAWN[8] = {                     // by rank, from the pawn's own side
+    makeScore(0, 0), makeScore(5, 10), makeScore(10, 15), makeScore(15, 25),
+    makeScore(25, 45), makeScore(40, 70), makeScore(60, 110), makeScore(0, 0)
+};
+
+// Two bitboards handled as one value: lane 0 is White, lane 1 is Black mirrored onto
+// White's side of the board, so one sequence of shifts evaluates both colors
+struct ScalarLanes {
+    Bitboard v[2];
+    static ScalarLanes load(const Bitboard b[2]) { return ScalarLanes{ { b[0], b[1] } }; }
+    static ScalarLanes splat(Bitboard b) { return ScalarLanes{ { b, b } }; }
+    void store(Bitboard out[2]) const { out[0] = v[0]; out[1] = v[1]; }
+};
+static inline ScalarLanes operator&(ScalarLanes a, ScalarLanes b) { return ScalarLanes{ { a.v[0] & b.v[0], a.v[1] & b.v[1] } }; }
+static inline ScalarLanes operator|(ScalarLanes a, ScalarLanes b) { return ScalarLanes{ { a.v[0] | b.v[0], a.v[1] | b.v[1] } }; }
+static inline ScalarLanes andNot(ScalarLanes a, ScalarLanes b) { return ScalarLanes{ { a.v[0] & ~b.v[0], a.v[1] & ~b.v[1] } }; }
+// Shift towards higher squares for D > 0, lower squares for D < 0
+template <int D>
+static inline ScalarLanes shiftLanes(ScalarLanes a) {
+    return D > 0 ? ScalarLanes{ { a.v[0] << (D > 0 ? D : 0), a.v[1] << (D > 0 ? D : 0) } }
+                 : ScalarLanes{ { a.v[0] >> (D < 0 ? -D : 0), a.v[1] >> (D < 0 ? -D : 0) } };
+}
+
+#ifdef EVALUATE_SSE2
+struct SseLanes {
+    __m128i v;
+    static SseLanes load(const Bitboard b[2]) { return SseLanes{ _mm_loadu_si128((const __m128i*)b) }; }
+    static SseLanes splat(Bitboard b) { return SseLanes{ _mm_set1_epi64x((long long)b) }; }
+    void store(Bitboard out[2]) const { _mm_storeu_si128((__m128i*)out, v); }
+};
+static inline SseLanes operator&(SseLanes a, SseLanes b) { return SseLanes{ _mm_and_si128(a.v, b.v) }; }
+static inline SseLanes operator|(SseLanes a, SseLanes b) { return SseLanes{ _mm_or_si128(a.v, b.v) }; }
+static inline SseLanes andNot(SseLanes a, SseLanes b) { return SseLanes{ _mm_andnot_si128(b.v, a.v) }; }
+template <int D>
+static inline SseLanes shiftLanes(SseLanes a) {
+    return D > 0 ? SseLanes{ _mm_slli_epi64(a.v, D > 0 ? D : 0) } : SseLanes{ _mm_srli_epi64(a.v, D < 0 ? -D : 0) };
+}
+#endif
+
+// Kogge-Stone occluded fill, as slideAttacks() in Bitboard.h
+template <int D, class V>
+static inline V slide(V gen, V empty, V wrap) {
+    V pro = empty & wrap;
+    gen = gen | (pro & shiftLanes<D>(gen));     pro = pro & shiftLanes<D>(pro);
+    gen = gen | (pro & shiftLanes<2 * D>(gen)); pro = pro & shiftLanes<2 * D>(pro);
+    gen = gen | (pro & shiftLanes<4 * D>(gen));
+    return shiftLanes<D>(gen) & wrap;
+}
+
+template <class V> static inline V northFill(V b) { b = b | shiftLanes<8>(b); b = b | shiftLanes<16>(b); return b | shiftLanes<32>(b); }
+template <class V> static inline V southFill(V b) { b = b | shiftLanes<-8>(b); b = b | shiftLanes<-16>(b); return b | shiftLanes<-32>(b); }
+
+// Kernel inputs, each as a White/Black lane pair seen from the owner's side
+enum KernelInput { OWN_PAWNS, ENEMY_PAWNS, KNIGHTS, DIAGONALS, ORTHOGONALS, OWN_PIECES, OCCUPIED, INPUT_COUNT };
+// Kernel outputs: square sets whose population counts are weighted per lane
+enum KernelOutput { KNIGHT_TARGETS, DIAGONAL_TARGETS, ORTHOGONAL_TARGETS, DOUBLED, ISOLATED, PASSED, OUTPUT_COUNT };
+
+template <class V>
+static void structureKernel(const Bitboard in[INPUT_COUNT][2], Bitboard out[OUTPUT_COUNT][2]) {
+    const V all = V::splat(~0ULL), notA = V::splat(~FILE_A_BB), notH = V::splat(~FILE_H_BB);
+    const V notAB = V::splat(~(FILE_A_BB | (FILE_A_BB << 1))), notGH = V::splat(~(FILE_H_BB | (FILE_H_BB >> 1)));
+    V pawns = V::load(in[OWN_PAWNS]), enemyPawns = V::load(in[ENEMY_PAWNS]);
+    V empty = andNot(all, V::load(in[OCCUPIED]));
+
+    // Enemy pawns move down the board in both lanes
+    V pawnGuarded = (shiftLanes<-7>(enemyPawns) & notA) | (shiftLanes<-9>(enemyPawns) & notH);
+    V safe = andNot(andNot(all, V::load(in[OWN_PIECES])), pawnGuarded);
+
+    V n = V::load(in[KNIGHTS]);
+    V l1 = shiftLanes<-1>(n) & notH, l2 = shiftLanes<-2>(n) & notGH;
+    V r1 = shiftLanes<1>(n) & notA, r2 = shiftLanes<2>(n) & notAB;
+    V h1 = l1 | r1, h2 = l2 | r2;
+    V knight = shiftLanes<16>(h1) | shiftLanes<-16>(h1) | shiftLanes<8>(h2) | shiftLanes<-8>(h2);
+
+    V d = V::load(in[DIAGONALS]);
+    V diagonal = slide<9>(d, empty, notA) | slide<7>(d, empty, notH) | slide<-7>(d, empty, notA) | slide<-9>(d, empty, notH);
+    V o = V::load(in[ORTHOGONALS]);
+    V orthogonal = slide<8>(o, empty, all) | slide<-8>(o, empty, all) | slide<1>(o, empty, notA) | slide<-1>(o, empty, notH);
+
+    (knight & safe).store(out[KNIGHT_TARGETS]);
+    (diagonal & safe).store(out[DIAGONAL_TARGETS]);
+    (orthogonal & safe).store(out[ORTHOGONAL_TARGETS]);
+
+    // Doubled: a pawn with an own pawn behind it. Isolated: no own pawn on a neighbouring
+    // file. Passed: no enemy pawn ahead on its own or a neighbouring file
+    (pawns & northFill(shiftLanes<8>(pawns))).store(out[DOUBLED]);
+    V files = northFill(pawns) | southFill(pawns);
+    andNot(pawns, (shiftLanes<1>(files) & notA) | (shiftLanes<-1>(files) & notH)).store(out[ISOLATED]);
+    V blocked = southFill(shiftLanes<-8>(enemyPawns));
+    andNot(pawns, blocked | (shiftLanes<1>(blocked) & notA) | (shiftLanes<-1>(blocked) & notH)).store(out[PASSED]);
+}
+
+bool Evaluate::simdSupported() {
+#ifdef EVALUATE_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Evaluate::setSimdEnabled(bool enabled) {
+    useSimd = enabled && simdSupported();
+}
+
+Score Evaluate::structure(const Position& pos) {
+    Bitboard in[INPUT_COUNT][2];
+    for (int c = 0; c < 2; ++c) {
+        bool white = c == 0;
+        auto own = [white](Bitboard b) { return white ? b : flipVertical(b); };
+        Bitboard queens = pos.pieces(white, PieceType::QUEEN);
+        in[OWN_PAWNS][c] = own(pos.pieces(white, PieceType::PAWN));
+        in[ENEMY_PAWNS][c] = own(pos.pieces(!white, PieceType::PAWN));
+        in[KNIGHTS][c] = own(pos.pieces(white, PieceType::KNIGHT));
+        in[DIAGONALS][c] = own(pos.pieces(white, PieceType::BISHOP) | queens);
+        in[ORTHOGONALS][c] = own(pos.pieces(white, PieceType::ROOK) | queens);
+        in[OWN_PIECES][c] = own(pos.pieces(white));
+        in[OCCUPIED][c] = own(pos.occupied());
+    }
+    Bitboard out[OUTPUT_COUNT][2];
+#ifdef EVALUATE_SSE2
+    if (useSimd) structureKernel<SseLanes>(in, out);
+    else
+#endif
+    structureKernel<ScalarLanes>(in, out);
+
+    Score s[2];
+    for (int c = 0; c < 2; ++c) {
+        s[c] = KNIGHT_MOBILITY * popCount(out[KNIGHT_TARGETS][c])
+             + DIAGONAL_MOBILITY * popCount(out[DIAGONAL_TARGETS][c])
+             + ORTHOGONAL_MOBILITY * popCount(out[ORTHOGONAL_TARGETS][c])
+             + DOUBLED_PAWN * popCount(out[DOUBLED][c])
+             + ISOLATED_PAWN * popCount(out[ISOLATED][c]);
+        for (Bitboard p = out[PASSED][c]; p; ) s[c] += PASSED_PAWN[rankOf(popLsb(p))];
+    }
+    return s[0] - s[1];
+}
+
+int Evaluate::evaluate(const Position& pos) {
+    Score s = pos.psqScore() + structure(pos);
+    int phase = std::min(pos.gamePhase(), Psqt::MAX_PHASE);
+    int score = (mgScore(s) * phase + egScore(s) * (Psqt::MAX_PHASE - phase)) / Psqt::MAX_PHASE;
+    return pos.whiteToMove() ? score : -score;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Feature/basic/GameLogic/Position.h"
+
+// Static evaluation, tapered from middlegame to endgame by the remaining non-pawn material:
+// material plus piece-square tables (kept incrementally by Position), mobility and pawn
+// structure. The last two are computed set-wise from bitboards for both colors at once,
+// on SSE2 lanes where the build targets it and on a scalar pair otherwise.
+class Evaluate {
+public:
+    static const int PIECE_VALUE[6]; // indexed by PieceType, centipawns (move ordering)
+
+    // Score in centipawns from the side to move's point of view
+    static int evaluate(const Position& pos);
+
+    // Mobility and pawn-structure terms, White minus Black
+    static Score structure(const Position& pos);
+
+    // The SIMD kernel is on by default when compiled in; both kernels give identical scores
+    static bool simdSupported();
+    static bool simdEnabled() { return useSimd; }
+    static void setSimdEnabled(bool enabled);
+
+private:
+    static bool useSimd;
+};
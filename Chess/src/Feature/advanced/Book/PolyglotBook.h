@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Feature/basic/GameLogic/Position.h"
+#include "mappedfile.h"
+
+struct BookMove {
+    Move move;          // legal in the probed position
+    uint16_t weight;
+};
+
+// Polyglot opening book (.bin): 16-byte big-endian entries sorted by position key. The
+// file is memory-mapped and binary-searched in place, so opening a book costs nothing
+// until it is probed and only the touched pages are ever read. Keys come from Polyglot's
+// fixed 781-entry Random64 table, compiled in.
+class PolyglotBook {
+public:
+    PolyglotBook() {}
+    PolyglotBook(const PolyglotBook&) = delete;
+    PolyglotBook& operator=(const PolyglotBook&) = delete;
+
+    // Map the book
+    bool open(const std::string& bookPath);
+    void close();
+    bool isOpen() const { return entries > 0; }
+    size_t size() const { return entries; }
+
+    // Legal book moves of the side to move, in file order (best first in standard books).
+    // Empty when out of book
+    std::vector<BookMove> probe(const Position& pos) const;
+    // Weighted random pick; 'random' is any uniformly distributed value. None if out of book
+    Move pick(const Position& pos, uint64_t random) const;
+
+    // Polyglot hash of pos
+    static uint64_t key(const Position& pos);
+
+private:
+    MappedFile file;
+    size_t entries = 0;
+};
@@ -0,0 +1,299 @@
+#include "Nnue.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define NNUE_X86 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Vector kernels are compiled per function, so the TU itself needs no -mavx2
+#if defined(__GNUC__) || defined(__clang__)
+#define NNUE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NNUE_TARGET(isa)
+#endif
+
+const char Nnue::MAGIC[8] = { 'C', '3', 'D', 'N', 'N', 'U', 'E', '1' };
+Nnue::Kernel Nnue::activeKernel = Nnue::bestKernel();
+
+static const int MAX_ROWS = 64;
+
+// One kernel set per instruction set. Every set computes exactly the scalar results:
+// int16 sums wrap identically, and dense weights within [-127, 127] keep the pairwise
+// u8 x s8 products of maddubs below int16 saturation
+struct NnueKernels {
+    // dst = src + sum(add rows) - sum(sub rows), HALF int16 lanes
+    void (*accumulate)(int16_t* dst, const int16_t* src, const int16_t* const* add, int addCount,
+                       const int16_t* const* sub, int subCount);
+    // Clip both perspectives into [0, 127]: out[0..HALF) from 'us', out[HALF..2*HALF) from 'them'
+    void (*transform)(const int16_t* us, const int16_t* them, uint8_t* out);
+    // Dot product of n unsigned inputs with n signed weights (n a multiple of 32)
+    int32_t (*dot)(const uint8_t* in, const int8_t* w, int n);
+};
+
+static void accumulateScalar(int16_t* dst, const int16_t* src, const int16_t* const* add, int addCount,
+                             const int16_t* const* sub, int subCount) {
+    for (int i = 0; i < Nnue::HALF; ++i) {
+        int v = src[i];
+        for (int k = 0; k < addCount; ++k) v += add[k][i];
+        for (int k = 0; k < subCount; ++k) v -= sub[k][i];
+        dst[i] = (int16_t)v;
+    }
+}
+
+static void transformScalar(const int16_t* us, const int16_t* them, uint8_t* out) {
+    for (int i = 0; i < Nnue::HALF; ++i) {
+        out[i] = (uint8_t)std::min(std::max((int)us[i], 0), 127);
+        out[Nnue::HALF + i] = (uint8_t)std::min(std::max((int)them[i], 0), 127);
+    }
+}
+
+static int32_t dotScalar(const uint8_t* in, const int8_t* w, int n) {
+    int32_t sum = 0;
+    for (int i = 0; i < n; ++i) sum += in[i] * w[i];
+    return sum;
+}
+
+#ifdef NNUE_X86
+NNUE_TARGET("sse4.1")
+static void accumulateSse41(int16_t* dst, const int16_t* src, const int16_t* const* add, int addCount,
+                            const int16_t* const* sub, int subCount) {
+    // 64 lanes per pass stay in eight registers while every row streams through
+    for (int c = 0; c < Nnue::HALF; c += 64) {
+        __m128i r[8];
+        for (int j = 0; j < 8; ++j) r[j] = _mm_loadu_si128((const __m128i*)(src + c + 8 * j));
+        for (int k = 0; k < addCount; ++k)
+            for (int j = 0; j < 8; ++j) r[j] = _mm_add_epi16(r[j], _mm_loadu_si128((const __m128i*)(add[k] + c + 8 * j)));
+        for (int k = 0; k < subCount; ++k)
+            for (int j = 0; j < 8; ++j) r[j] = _mm_sub_epi16(r[j], _mm_loadu_si128((const __m128i*)(sub[k] + c + 8 * j)));
+        for (int j = 0; j < 8; ++j) _mm_storeu_si128((__m128i*)(dst + c + 8 * j), r[j]);
+    }
+}
+
+NNUE_TARGET("sse4.1")
+static void transformSse41(const int16_t* us, const int16_t* them, uint8_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    for (int h = 0; h < 2; ++h) {
+        const int16_t* in = h == 0 ? us : them;
+        for (int i = 0; i < Nnue::HALF; i += 16) {
+            __m128i packed = _mm_packs_epi16(_mm_loadu_si128((const __m128i*)(in + i)), _mm_loadu_si128((const __m128i*)(in + i + 8)));
+            _mm_storeu_si128((__m128i*)(out + h * Nnue::HALF + i), _mm_max_epi8(packed, zero));
+        }
+    }
+}
+
+NNUE_TARGET("sse4.1")
+static int32_t dotSse41(const uint8_t* in, const int8_t* w, int n) {
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 16) {
+        __m128i pairs = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*)(in + i)), _mm_loadu_si128((const __m128i*)(w + i)));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, ones));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+NNUE_TARGET("avx2")
+static void accumulateAvx2(int16_t* dst, const int16_t* src, const int16_t* const* add, int addCount,
+                           const int16_t* const* sub, int subCount) {
+    // The whole 128-lane half fits in eight registers
+    __m256i r[Nnue::HALF / 16];
+    for (int j = 0; j < Nnue::HALF / 16; ++j) r[j] = _mm256_loadu_si256((const __m256i*)(src + 16 * j));
+    for (int k = 0; k < addCount; ++k)
+        for (int j = 0; j < Nnue::HALF / 16; ++j) r[j] = _mm256_add_epi16(r[j], _mm256_loadu_si256((const __m256i*)(add[k] + 16 * j)));
+    for (int k = 0; k < subCount; ++k)
+        for (int j = 0; j < Nnue::HALF / 16; ++j) r[j] = _mm256_sub_epi16(r[j], _mm256_loadu_si256((const __m256i*)(sub[k] + 16 * j)));
+    for (int j = 0; j < Nnue::HALF / 16; ++j) _mm256_storeu_si256((__m256i*)(dst + 16 * j), r[j]);
+}
+
+NNUE_TARGET("avx2")
+static void transformAvx2(const int16_t* us, const int16_t* them, uint8_t* out) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (int h = 0; h < 2; ++h) {
+        const int16_t* in = h == 0 ? us : them;
+        for (int i = 0; i < Nnue::HALF; i += 32) {
+            __m256i packed = _mm256_packs_epi16(_mm256_loadu_si256((const __m256i*)(in + i)), _mm256_loadu_si256((const __m256i*)(in + i + 16)));
+            // packs works per 128-bit lane; restore the element order
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256((__m256i*)(out + h * Nnue::HALF + i), _mm256_max_epi8(packed, zero));
+        }
+    }
+}
+
+NNUE_TARGET("avx2")
+static int32_t dotAvx2(const uint8_t* in, const int8_t* w, int n) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 32) {
+        __m256i pairs = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(in + i)), _mm256_loadu_si256((const __m256i*)(w + i)));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(pairs, ones));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+static const NnueKernels KERNELS[3] = {
+    { accumulateScalar, transformScalar, dotScalar },
+    { accumulateSse41, transformSse41, dotSse41 },
+    { accumulateAvx2, transformAvx2, dotAvx2 },
+};
+#else
+static const NnueKernels KERNELS[3] = {
+    { accumulateScalar, transformScalar, dotScalar },
+    { accumulateScalar, transformScalar, dotScalar },
+    { accumulateScalar, transformScalar, dotScalar },
+};
+#endif
+
+Nnue::Kernel Nnue::bestKernel() {
+#if defined(NNUE_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Kernel::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return Kernel::SSE41;
+#elif defined(NNUE_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6; // OS saves the ymm registers
+    __cpuidex(info, 7, 0);
+    if (osAvx && (info[1] & (1 << 5))) return Kernel::AVX2;
+    if (sse41) return Kernel::SSE41;
+#endif
+    return Kernel::SCALAR;
+}
+
+void Nnue::setKernel(Kernel k) {
+    activeKernel = std::min(k, bestKernel());
+}
+
+const char* Nnue::kernelName(Kernel k) {
+    switch (k) {
+        case Kernel::AVX2:  return "avx2";
+        case Kernel::SSE41: return "sse4.1";
+        default:            return "scalar";
+    }
+}
+
+static uint32_t readLe32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool Nnue::load(const std::string& path, std::string& error) {
+    close();
+    const size_t dense = L2 * 4 + (size_t)L2 * 2 * HALF + L3 * 4 + (size_t)L3 * L2 + 4 + L3;
+    const size_t expected = HEADER_SIZE + HALF * 2 + (size_t)INPUTS * HALF * 2 + dense;
+    if (!file.open(path)) { error = "cannot open " + path; return false; }
+    if (file.size() != expected) { error = path + " has the wrong size for this network"; close(); return false; }
+    // Transformer rows are read in no particular order
+    if (!file.map(0, expected, false)) { error = "cannot map " + path; close(); return false; }
+
+    const unsigned char* p = (const unsigned char*)file.data();
+    static const uint32_t DIMS[5] = { (uint32_t)INPUTS, (uint32_t)HALF, (uint32_t)L2, (uint32_t)L3, 1 };
+    bool ok = std::memcmp(p, MAGIC, 8) == 0;
+    for (int i = 0; i < 5 && ok; ++i) ok = readLe32(p + 8 + 4 * i) == DIMS[i];
+    if (!ok) { error = path + " is not a network of this architecture"; close(); return false; }
+
+    // The int16 transformer is used in place (little-endian hosts, like the file)
+    ftBiases = (const int16_t*)(p + HEADER_SIZE);
+    const unsigned char* q = p + HEADER_SIZE + HALF * 2 + (size_t)INPUTS * HALF * 2;
+    auto readLayer = [&](int32_t* biases, std::vector<int8_t>& weights, int outputs, int inputs) {
+        for (int i = 0; i < outputs; ++i, q += 4) biases[i] = (int32_t)readLe32(q);
+        weights.assign((const int8_t*)q, (const int8_t*)q + (size_t)outputs * inputs);
+        q += (size_t)outputs * inputs;
+        return std::find(weights.begin(), weights.end(), (int8_t)-128) == weights.end();
+    };
+    if (!readLayer(l2Biases, l2Weights, L2, 2 * HALF) || !readLayer(l3Biases, l3Weights, L3, L2) ||
+        !readLayer(&outBias, outWeights, 1, L3)) {
+        error = path + ": dense weights must lie in [-127, 127]";
+        close();
+        return false;
+    }
+    ftWeights = ftBiases + HALF;
+    return true;
+}
+
+void Nnue::close() {
+    file.close();
+    ftBiases = ftWeights = nullptr;
+}
+
+// Feature of one man as seen by 'perspective' (0 White, 1 Black) with its king on 'kingSq'
+static int featureIndex(int perspective, int kingSq, int type, bool white, int sq) {
+    if (perspective == 1) { kingSq ^= 56; sq ^= 56; }
+    int piece = type * 2 + (white == (perspective == 0) ? 0 : 1);
+    return (kingSq * 10 + piece) * 64 + sq;
+}
+
+void Nnue::delta(const Position& pos, Move m, NnueDelta& d) {
+    d = NnueDelta();
+    int from = m.from(), to = m.to();
+    bool white = pos.isWhiteAt(from);
+    PieceType type = pos.typeAt(from);
+    auto change = [](NnueDelta::Change& c, PieceType t, bool w, int sq) { c.type = (int8_t)t; c.white = (int8_t)w; c.sq = (int8_t)sq; };
+    if (m.kind() == MoveKind::CASTLING) {
+        d.kingMoved[white ? 0 : 1] = true;
+        bool kingSide = to > from;
+        change(d.removed[d.removedCount++], PieceType::ROOK, white, kingSide ? to + 1 : to - 2);
+        change(d.added[d.addedCount++], PieceType::ROOK, white, kingSide ? to - 1 : to + 1);
+        return;
+    }
+    int capSq = m.kind() == MoveKind::EN_PASSANT ? to + (white ? -8 : 8) : to;
+    if (!pos.isEmpty(capSq)) change(d.removed[d.removedCount++], pos.typeAt(capSq), !white, capSq);
+    if (type == PieceType::KING) {
+        d.kingMoved[white ? 0 : 1] = true;
+        return;
+    }
+    change(d.removed[d.removedCount++], type, white, from);
+    change(d.added[d.addedCount++], m.kind() == MoveKind::PROMOTION ? m.promotion() : type, white, to);
+}
+
+void Nnue::refresh(const Position& pos, NnueAccumulator& acc, int perspective) const {
+    const int16_t* rows[MAX_ROWS];
+    int n = 0;
+    int kingSq = pos.kingSquare(perspective == 0);
+    for (Bitboard b = pos.occupied() & ~pos.pieces(PieceType::KING); b && n < MAX_ROWS; ) {
+        int sq = popLsb(b);
+        rows[n++] = ftWeights + (size_t)featureIndex(perspective, kingSq, (int)pos.typeAt(sq), pos.isWhiteAt(sq), sq) * HALF;
+    }
+    KERNELS[(int)activeKernel].accumulate(acc.values[perspective], ftBiases, rows, n, nullptr, 0);
+    acc.computed[perspective] = true;
+}
+
+void Nnue::update(const NnueAccumulator& parent, const NnueDelta& d, const Position& pos, NnueAccumulator& child, int perspective) const {
+    const int16_t* add[1];
+    const int16_t* sub[2];
+    int kingSq = pos.kingSquare(perspective == 0);
+    for (int i = 0; i < d.addedCount; ++i)
+        add[i] = ftWeights + (size_t)featureIndex(perspective, kingSq, d.added[i].type, d.added[i].white != 0, d.added[i].sq) * HALF;
+    for (int i = 0; i < d.removedCount; ++i)
+        sub[i] = ftWeights + (size_t)featureIndex(perspective, kingSq, d.removed[i].type, d.removed[i].white != 0, d.removed[i].sq) * HALF;
+    KERNELS[(int)activeKernel].accumulate(child.values[perspective], parent.values[perspective], add, d.addedCount, sub, d.removedCount);
+    child.computed[perspective] = true;
+}
+
+int Nnue::evaluate(const Position& pos, const NnueAccumulator& acc) const {
+    const NnueKernels& k = KERNELS[(int)activeKernel];
+    int us = pos.whiteToMove() ? 0 : 1;
+    uint8_t input[2 * HALF], hidden1[L2], hidden2[L3];
+    k.transform(acc.values[us], acc.values[us ^ 1], input);
+    for (int i = 0; i < L2; ++i)
+        hidden1[i] = (uint8_t)std::min(std::max((l2Biases[i] + k.dot(input, &l2Weights[(size_t)i * 2 * HALF], 2 * HALF)) >> 6, 0), 127);
+    for (int i = 0; i < L3; ++i)
+        hidden2[i] = (uint8_t)std::min(std::max((l3Biases[i] + k.dot(hidden1, &l3Weights[(size_t)i * L2], L2)) >> 6, 0), 127);
+    return (outBias + k.dot(hidden2, outWeights.data(), L3)) / 16;
+}
+
+int Nnue::evaluate(const Position& pos) const {
+    NnueAccumulator acc;
+    refresh(pos, acc, 0);
+    refresh(pos, acc, 1);
+    return evaluate(pos, acc);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Feature/basic/GameLogic/Position.h"
+#include "mappedfile.h"
+
+struct NnueAccumulator;
+
+// Feature changes of one move: at most two men leave a square and one arrives (kings are
+// not features; a king move instead invalidates its own side's perspective)
+struct NnueDelta {
+    struct Change { int8_t type, white, sq; };
+    Change removed[2], added[1];
+    int removedCount = 0, addedCount = 0;
+    bool kingMoved[2] = { false, false };
+};
+
+// Efficiently updatable network with HalfKP-style inputs: for each perspective, the own
+// king square times every non-king man (type, color relative to the perspective, square),
+// both seen from that side of the board. Layers:
+//   feature transformer 40960 -> 128 per perspective (int16), side to move first,
+//   clipped to [0, 127] -> 256 x 32 (int8 weights, int32 biases, >> 6, clipped)
+//   -> 32 x 32 (same) -> 32 x 1, divided by 16 into centipawns for the side to move.
+//
+// Weight file (little-endian): the 8-byte magic "C3DNNUE1", five uint32 dimensions
+// (INPUTS, HALF, L2, L3, 1), padding to 64 bytes, then the transformer biases (int16[HALF])
+// and weights (int16[INPUTS][HALF]), then per dense layer the int32 biases followed by the
+// int8 weights, one row per output. Dense weights must lie in [-127, 127] so the vector
+// kernels' pairwise int16 sums cannot saturate. The transformer weights are used in place
+// from the memory-mapped file; only the small dense layers are copied.
+class Nnue {
+public:
+    static const int INPUTS = 64 * 10 * 64;
+    static const int HALF = 128;
+    static const int L2 = 32;
+    static const int L3 = 32;
+    static const char MAGIC[8];
+    static const size_t HEADER_SIZE = 64;
+
+    // Vector kernels are picked at runtime from what the CPU supports
+    enum class Kernel { SCALAR, SSE41, AVX2 };
+    static Kernel bestKernel();
+    static Kernel kernel() { return activeKernel; }
+    // Falls back to the best supported kernel below the requested one
+    static void setKernel(Kernel k);
+    static const char* kernelName(Kernel k);
+
+    Nnue() {}
+    Nnue(const Nnue&) = delete;
+    Nnue& operator=(const Nnue&) = delete;
+
+    // Map a weight file; false (with 'error' set) if it is missing or malformed
+    bool load(const std::string& path, std::string& error);
+    void close();
+    bool isLoaded() const { return ftWeights != nullptr; }
+
+    // Feature changes made by m; call before pos.makeMove(m)
+    static void delta(const Position& pos, Move m, NnueDelta& out);
+    // Rebuild one perspective of 'acc' from the pieces on the board
+    void refresh(const Position& pos, NnueAccumulator& acc, int perspective) const;
+    // child = parent plus d for one perspective whose king did not move; 'pos' is after the move
+    void update(const NnueAccumulator& parent, const NnueDelta& d, const Position& pos, NnueAccumulator& child, int perspective) const;
+    // Centipawns for the side to move from an up-to-date accumulator
+    int evaluate(const Position& pos, const NnueAccumulator& acc) const;
+    // Same, refreshing a temporary accumulator first
+    int evaluate(const Position& pos) const;
+
+private:
+    static Kernel activeKernel;
+
+    MappedFile file;
+    const int16_t* ftBiases = nullptr;
+    const int16_t* ftWeights = nullptr;
+    int32_t l2Biases[L2], l3Biases[L3], outBias = 0;
+    std::vector<int8_t> l2Weights, l3Weights, outWeights;
+};
+
+// First layer outputs of both perspectives: [0] from White's side, [1] from Black's.
+// Kept per search ply and brought up to date lazily from the moves in between
+struct NnueAccumulator {
+    int16_t values[2][Nnue::HALF];
+    bool computed[2] = { false, false };
+};
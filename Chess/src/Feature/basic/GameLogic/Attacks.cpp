@@ -0,0 +1,133 @@
+#include "Attacks.h"
+#include <cstddef>
+#include <vector>
+
+Bitboard Attacks::knightTable[64];
+Bitboard Attacks::kingTable[64];
+Bitboard Attacks::pawnTable[2][64];
+Bitboard Attacks::betweenTable[64][64];
+Bitboard Attacks::lineTable[64][64];
+Attacks::Slider Attacks::bishopSliders[64];
+Attacks::Slider Attacks::rookSliders[64];
+bool Attacks::usePext = false;
+
+// Fancy magic tables: every square owns 2^bits consecutive entries
+static Bitboard rookMagicTable[0x19000];
+static Bitboard bishopMagicTable[0x1480];
+static Bitboard rookPextTable[0x19000];
+static Bitboard bishopPextTable[0x1480];
+
+// Build tables before main() so the first lookup never pays for it
+static struct AttacksStartup { AttacksStartup() { Attacks::init(); } } attacksStartup;
+
+// xorshift64* generator with a fixed seed: magic search is deterministic run to run
+struct MagicRng {
+    uint64_t s;
+    explicit MagicRng(uint64_t seed) : s(seed) {}
+    uint64_t next() { s ^= s >> 12; s ^= s << 25; s ^= s >> 27; return s * 2685821657736338717ULL; }
+    uint64_t sparse() { return next() & next() & next(); }
+};
+
+void Attacks::init() {
+    static const bool ready = build(); // C++11 guarantees one thread runs build()
+    (void)ready;
+}
+
+bool Attacks::pextSupported() {
+#if defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 8)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") != 0;
+#else
+    return false;
+#endif
+}
+
+void Attacks::setPextEnabled(bool enabled) {
+    init();
+    usePext = enabled && pextSupported();
+    for (int sq = 0; sq < 64; ++sq) {
+        bishopSliders[sq].attacks = usePext ? bishopSliders[sq].pextAttacks : bishopSliders[sq].magicAttacks;
+        rookSliders[sq].attacks = usePext ? rookSliders[sq].pextAttacks : rookSliders[sq].magicAttacks;
+    }
+}
+
+// Portable PEXT used only while filling the table (hardware PEXT may be absent)
+static uint64_t softwarePext(uint64_t src, uint64_t mask) {
+    uint64_t r = 0;
+    for (uint64_t bit = 1; mask; bit <<= 1) {
+        if (src & mask & (0 - mask)) r |= bit;
+        mask &= mask - 1;
+    }
+    return r;
+}
+
+void Attacks::buildSliders(Slider* sliders, Bitboard* magicTable, Bitboard* pextTable, bool rook) {
+    std::vector<Bitboard> occupancy(4096), reference(4096);
+    std::vector<int> epoch(4096, 0);
+    int attempt = 0;
+    size_t offset = 0;
+    MagicRng rng(rook ? 0x9E3779B97F4A7C15ULL : 0xD1B54A32D192ED03ULL);
+
+    for (int sq = 0; sq < 64; ++sq) {
+        Slider& s = sliders[sq];
+        Bitboard b = squareBB(sq);
+        // Edge squares never block anything further along the ray
+        Bitboard edges = ((RANK_1_BB | RANK_8_BB) & ~(RANK_1_BB << (8 * rankOf(sq))))
+                       | ((FILE_A_BB | FILE_H_BB) & ~(FILE_A_BB << fileOf(sq)));
+        s.mask = (rook ? rookAttacksBB(b, 0) : bishopAttacksBB(b, 0)) & ~edges;
+        int bits = popCount(s.mask);
+        s.shift = 64 - bits;
+        s.magicAttacks = magicTable + offset;
+        s.pextAttacks = pextTable + offset;
+
+        // Enumerate every subset of the mask (Carry-Rippler) with its true attack set
+        int size = 0;
+        Bitboard occ = 0;
+        do {
+            occupancy[size] = occ;
+            reference[size] = rook ? rookAttacksBB(b, occ) : bishopAttacksBB(b, occ);
+            s.pextAttacks[softwarePext(occ, s.mask)] = reference[size];
+            ++size;
+            occ = (occ - s.mask) & s.mask;
+        } while (occ);
+
+        // Search a collision-free magic multiplier
+        for (int i = 0; i < size; ) {
+            do s.magic = rng.sparse(); while (popCount((s.magic * s.mask) >> 56) < 6);
+            ++attempt;
+            for (i = 0; i < size; ++i) {
+                unsigned idx = (unsigned)((occupancy[i] * s.magic) >> s.shift);
+                if (epoch[idx] < attempt) { epoch[idx] = attempt; s.magicAttacks[idx] = reference[i]; }
+                else if (s.magicAttacks[idx] != reference[i]) break;
+            }
+        }
+        offset += (size_t)size;
+    }
+}
+
+bool Attacks::build() {
+    for (int sq = 0; sq < 64; ++sq) {
+        Bitboard b = squareBB(sq);
+        knightTable[sq] = knightAttacksBB(b);
+        kingTable[sq] = kingAttacksBB(b);
+        pawnTable[0][sq] = pawnAttacksBB(b, true);
+        pawnTable[1][sq] = pawnAttacksBB(b, false);
+    }
+    buildSliders(bishopSliders, bishopMagicTable, bishopPextTable, false);
+    buildSliders(rookSliders, rookMagicTable, rookPextTable, true);
+    for (int a = 0; a < 64; ++a)
+        for (int b = 0; b < 64; ++b) {
+            betweenTable[a][b] = betweenBB(a, b);
+            lineTable[a][b] = lineBB(a, b);
+        }
+    usePext = pextSupported();
+    for (int sq = 0; sq < 64; ++sq) {
+        bishopSliders[sq].attacks = usePext ? bishopSliders[sq].pextAttacks : bishopSliders[sq].magicAttacks;
+        rookSliders[sq].attacks = usePext ? rookSliders[sq].pextAttacks : rookSliders[sq].magicAttacks;
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Bitboard.h"
+
+// Precomputed attack tables built once at startup:
+// leaper tables for knight/king/pawn, fancy-magic tables for sliders and,
+// on CPUs with BMI2, a PEXT-indexed slider table selected at runtime
+class Attacks {
+public:
+    // Build all tables (thread-safe, idempotent; also runs during static init)
+    static void init();
+
+    static Bitboard knight(int sq) { return knightTable[sq]; }
+    static Bitboard king(int sq) { return kingTable[sq]; }
+    static Bitboard pawn(bool white, int sq) { return pawnTable[white ? 0 : 1][sq]; }
+
+    static Bitboard bishop(int sq, Bitboard occ) {
+        const Slider& s = bishopSliders[sq];
+        return s.attacks[usePext ? pext64(occ, s.mask) : ((occ & s.mask) * s.magic) >> s.shift];
+    }
+    static Bitboard rook(int sq, Bitboard occ) {
+        const Slider& s = rookSliders[sq];
+        return s.attacks[usePext ? pext64(occ, s.mask) : ((occ & s.mask) * s.magic) >> s.shift];
+    }
+    static Bitboard queen(int sq, Bitboard occ) { return bishop(sq, occ) | rook(sq, occ); }
+
+    // Squares strictly between / full line through two aligned squares (empty if not aligned)
+    static Bitboard between(int a, int b) { return betweenTable[a][b]; }
+    static Bitboard line(int a, int b) { return lineTable[a][b]; }
+
+    // PEXT indexing is enabled automatically when the CPU reports BMI2
+    static bool pextSupported();
+    static bool pextEnabled() { return usePext; }
+    static void setPextEnabled(bool enabled);
+
+private:
+    struct Slider {
+        Bitboard mask;       // relevant occupancy (board edges excluded)
+        Bitboard magic;
+        Bitboard* attacks;   // points into the magic or the PEXT table
+        unsigned shift;
+        Bitboard* magicAttacks;
+        Bitboard* pextAttacks;
+    };
+
+    static uint64_t pext64(uint64_t src, uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return _pext_u64(src, mask);
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+        // Inline asm keeps the lookup inlinable without compiling the whole TU for BMI2
+        uint64_t r;
+        __asm__("pextq %2, %1, %0" : "=r"(r) : "r"(src), "r"(mask));
+        return r;
+#else
+        (void)src; (void)mask;
+        return 0; // never reached: PEXT is only enabled on x86-64 with BMI2
+#endif
+    }
+
+    static bool build();
+    static void buildSliders(Slider* sliders, Bitboard* magicTable, Bitboard* pextTable, bool rook);
+
+    static Bitboard knightTable[64];
+    static Bitboard kingTable[64];
+    static Bitboard pawnTable[2][64];
+    static Bitboard betweenTable[64][64];
+    static Bitboard lineTable[64][64];
+    static Slider bishopSliders[64];
+    static Slider rookSliders[64];
+    static bool usePext;
+};
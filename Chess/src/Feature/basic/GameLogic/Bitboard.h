@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 64-bit square sets: bit index = rank * 8 + file (a1 = 0, h1 = 7, a8 = 56)
+typedef uint64_t Bitboard;
+
+const Bitboard FILE_A_BB = 0x0101010101010101ULL;
+const Bitboard FILE_H_BB = FILE_A_BB << 7;
+const Bitboard RANK_1_BB = 0xFFULL;
+const Bitboard RANK_2_BB = RANK_1_BB << 8;
+const Bitboard RANK_7_BB = RANK_1_BB << 48;
+const Bitboard RANK_8_BB = RANK_1_BB << 56;
+
+inline int squareOf(int file, int rank) { return rank * 8 + file; }
+inline int fileOf(int sq) { return sq & 7; }
+inline int rankOf(int sq) { return sq >> 3; }
+inline Bitboard squareBB(int sq) { return 1ULL << sq; }
+
+inline int popCount(Bitboard b) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(b);
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+// Index of the least significant set bit (b must be non-zero)
+inline int lsbIndex(Bitboard b) {
+#if defined(_MSC_VER)
+    unsigned long idx; _BitScanForward64(&idx, b); return (int)idx;
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+// Pop and return the least significant set bit (b must be non-zero)
+inline int popLsb(Bitboard& b) {
+    int sq = lsbIndex(b);
+    b &= b - 1;
+    return sq;
+}
+
+// Mirror ranks (a1 <-> a8): Black's pieces seen from its own side of the board
+inline Bitboard flipVertical(Bitboard b) {
+#if defined(_MSC_VER)
+    return _byteswap_uint64(b);
+#else
+    return __builtin_bswap64(b);
+#endif
+}
+
+inline Bitboard shiftBB(Bitboard b, int d) { return d > 0 ? b << d : b >> -d; }
+
+// Kogge-Stone occluded fill: attacks of every slider in 'gen' along direction d.
+// 'wrap' masks squares that are valid after one step (drops file wrap-around).
+inline Bitboard slideAttacks(Bitboard gen, Bitboard empty, int d, Bitboard wrap) {
+    Bitboard pro = empty & wrap;
+    gen |= pro & shiftBB(gen, d);     pro &= shiftBB(pro, d);
+    gen |= pro & shiftBB(gen, 2 * d); pro &= shiftBB(pro, 2 * d);
+    gen |= pro & shiftBB(gen, 4 * d);
+    return shiftBB(gen, d) & wrap;
+}
+
+// Set-wise attack generation (accept any number of attackers in the input set)
+inline Bitboard rookAttacksBB(Bitboard rooks, Bitboard occ) {
+    Bitboard empty = ~occ;
+    return slideAttacks(rooks, empty, 8, ~0ULL) | slideAttacks(rooks, empty, -8, ~0ULL)
+         | slideAttacks(rooks, empty, 1, ~FILE_A_BB) | slideAttacks(rooks, empty, -1, ~FILE_H_BB);
+}
+
+inline Bitboard bishopAttacksBB(Bitboard bishops, Bitboard occ) {
+    Bitboard empty = ~occ;
+    return slideAttacks(bishops, empty, 9, ~FILE_A_BB) | slideAttacks(bishops, empty, 7, ~FILE_H_BB)
+         | slideAttacks(bishops, empty, -7, ~FILE_A_BB) | slideAttacks(bishops, empty, -9, ~FILE_H_BB);
+}
+
+inline Bitboard knightAttacksBB(Bitboard n) {
+    Bitboard l1 = (n >> 1) & ~FILE_H_BB, l2 = (n >> 2) & ~(FILE_H_BB | (FILE_H_BB >> 1));
+    Bitboard r1 = (n << 1) & ~FILE_A_BB, r2 = (n << 2) & ~(FILE_A_BB | (FILE_A_BB << 1));
+    Bitboard h1 = l1 | r1, h2 = l2 | r2;
+    return (h1 << 16) | (h1 >> 16) | (h2 << 8) | (h2 >> 8);
+}
+
+inline Bitboard kingAttacksBB(Bitboard k) {
+    Bitboard row = k | ((k << 1) & ~FILE_A_BB) | ((k >> 1) & ~FILE_H_BB);
+    return (row | (row << 8) | (row >> 8)) & ~k;
+}
+
+inline Bitboard pawnAttacksBB(Bitboard pawns, bool white) {
+    return white ? ((pawns << 9) & ~FILE_A_BB) | ((pawns << 7) & ~FILE_H_BB)
+                 : ((pawns >> 7) & ~FILE_A_BB) | ((pawns >> 9) & ~FILE_H_BB);
+}
+
+// Squares strictly between a and b when they share a rank, file or diagonal (else empty)
+inline Bitboard betweenBB(int a, int b) {
+    Bitboard A = squareBB(a), B = squareBB(b);
+    if (rookAttacksBB(A, 0) & B) return rookAttacksBB(A, B) & rookAttacksBB(B, A);
+    if (bishopAttacksBB(A, 0) & B) return bishopAttacksBB(A, B) & bishopAttacksBB(B, A);
+    return 0;
+}
+
+// Full line through a and b (both included) when aligned, else empty
+inline Bitboard lineBB(int a, int b) {
+    Bitboard A = squareBB(a), B = squareBB(b);
+    if (rookAttacksBB(A, 0) & B) return (rookAttacksBB(A, 0) & rookAttacksBB(B, 0)) | A | B;
+    if (bishopAttacksBB(A, 0) & B) return (bishopAttacksBB(A, 0) & bishopAttacksBB(B, 0)) | A | B;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "BoardSync.h"
+#include "GameLogic.h"
+
+void BoardSync::buildPosition(const std::vector<Piece>& pieces, Position& pos) {
+    // The game's Position keeps its attack maps across every move for the UI's check and
+    // castling queries
+    pos.setAttackTracking(true);
+    pos.clear();
+    for (int i = 0; i < (int)pieces.size(); ++i) {
+        const Piece& p = pieces[i];
+        if (!GameLogic::isValidSquare(p.file, p.rank)) continue; // captured/off-board
+        pos.addPiece(squareOf(p.file, p.rank), p.type, p.isWhite, i);
+    }
+    // Castling rights follow the king/rook hasMoved flags
+    uint8_t rights = 0;
+    auto unmoved = [&](int sq, PieceType t, bool white) {
+        int idx = pos.pieceIndexAt(sq);
+        return idx >= 0 && pos.typeAt(sq) == t && pos.isWhiteAt(sq) == white && !pieces[idx].hasMoved;
+    };
+    if (unmoved(4, PieceType::KING, true)) {
+        if (unmoved(7, PieceType::ROOK, true)) rights |= WHITE_OO;
+        if (unmoved(0, PieceType::ROOK, true)) rights |= WHITE_OOO;
+    }
+    if (unmoved(60, PieceType::KING, false)) {
+        if (unmoved(63, PieceType::ROOK, false)) rights |= BLACK_OO;
+        if (unmoved(56, PieceType::ROOK, false)) rights |= BLACK_OOO;
+    }
+    pos.setCastlingRights(rights);
+}
+
+int BoardSync::syncPieces(const Position& pos, std::vector<Piece>& pieces) {
+    int squareOfIndex[128];
+    for (int i = 0; i < 128; ++i) squareOfIndex[i] = -1;
+    for (Bitboard occ = pos.occupied(); occ; ) {
+        int sq = popLsb(occ);
+        int idx = pos.pieceIndexAt(sq);
+        if (idx >= 0 && idx < 128) squareOfIndex[idx] = sq;
+    }
+    int changed = 0;
+    for (int i = 0; i < (int)pieces.size() && i < 128; ++i) {
+        Piece& p = pieces[i];
+        int sq = squareOfIndex[i];
+        if (sq < 0) {
+            if (GameLogic::isValidSquare(p.file, p.rank)) { markCaptured(pieces, i); ++changed; }
+            continue;
+        }
+        if (p.file == fileOf(sq) && p.rank == rankOf(sq) && p.type == pos.typeAt(sq)) continue;
+        if (p.file != fileOf(sq) || p.rank != rankOf(sq)) p.hasMoved = true;
+        p.file = fileOf(sq);
+        p.rank = rankOf(sq);
+        p.type = pos.typeAt(sq);
+        ++changed;
+    }
+    return changed;
+}
+
+void BoardSync::markCaptured(std::vector<Piece>& pieces, int idx) {
+    if (idx < 0 || idx >= (int)pieces.size()) return;
+    pieces[idx].file = -999;
+    pieces[idx].rank = -999;
+    pieces[idx].model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -10.0f, 0.0f));
+}
+
+int BoardSync::findKingIndex(const std::vector<Piece>& pcs, bool isWhite) {
+    for (int i=0;i<(int)pcs.size();++i) if (pcs[i].type==PieceType::KING && pcs[i].file>=0 && pcs[i].rank>=0 && pcs[i].isWhite==isWhite) return i;
+    return -1;
+}
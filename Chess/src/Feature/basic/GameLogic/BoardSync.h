@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+#include "Types.h"
+#include "Position.h"
+
+// Bridge between the scene's piece list (meshes, transforms) and the rules Position.
+// Kept out of ChessCore because Piece carries GL state.
+class BoardSync {
+public:
+    // Position of a scene piece list: castling rights from the king/rook hasMoved flags,
+    // White to move, no en passant (captured pieces are skipped), attack tracking on.
+    // Called once per game: from then on the Position is the rules state, advanced by
+    // makeMove on commit, and rules queries read it instead of rebuilding from the pieces
+    static void buildPosition(const std::vector<Piece>& pieces, Position& pos);
+    // Copy placement back onto the scene pieces after pos.makeMove (captures, castling rook,
+    // en passant, promotion); returns the number of pieces that changed
+    static int syncPieces(const Position& pos, std::vector<Piece>& pieces);
+
+    // Move a piece off the board and out of sight
+    static void markCaptured(std::vector<Piece>& pieces, int idx);
+    static int findKingIndex(const std::vector<Piece>& pcs, bool isWhite);
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+// Rules-level value types shared by the headless ChessCore library and the game
+// (no GL or GLM here; the scene's Piece lives in Types.h)
+
+// Chess square representation
+struct ChessSquare {
+    int file; // 0-7 (a-h)
+    int rank; // 0-7 (1-8)
+    ChessSquare(int f, int r) : file(f), rank(r) {}
+    ChessSquare() : file(0), rank(0) {}
+};
+
+// Chess piece types
+enum class PieceType {
+    PAWN,
+    ROOK,
+    KNIGHT,
+    BISHOP,
+    QUEEN,
+    KING
+};
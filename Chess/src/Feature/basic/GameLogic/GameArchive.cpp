@@ -0,0 +1,197 @@
+#include "GameArchive.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include <algorithm>
+#include <cstring>
+
+const char GameArchive::MAGIC[8] = { 'C', '3', 'D', 'G', 'A', 'M', 'E', '1' };
+
+static const int ENCODING_MASK = 3;
+static const int CUSTOM_START = 4;
+
+static uint32_t read16(const unsigned char* p) { return p[0] | (uint32_t)p[1] << 8; }
+static uint32_t read32(const unsigned char* p) { return read16(p) | read16(p + 2) << 16; }
+static void put16(std::vector<unsigned char>& out, uint32_t v) { out.push_back((unsigned char)v); out.push_back((unsigned char)(v >> 8)); }
+static void put32(std::vector<unsigned char>& out, uint32_t v) { put16(out, v & 0xFFFF); put16(out, v >> 16); }
+
+// Rank of m among the legal moves ordered by Move value: its INDEX8 code
+static int moveIndex(const MoveList& legal, Move m) {
+    int index = 0;
+    for (const Move& other : legal) index += other.data < m.data;
+    return index;
+}
+
+// Whether a file starts with the header of an archive of this version
+static bool validHeader(const unsigned char* base, uint64_t size) {
+    return size >= GameArchive::FILE_HEADER_SIZE && std::memcmp(base, GameArchive::MAGIC, sizeof(GameArchive::MAGIC)) == 0
+        && read32(base + 8) == GameArchive::VERSION;
+}
+
+// Walk the records of a mapped archive and return the end of the last complete one; a torn
+// last record (interrupted append) is left out. Record offsets go to 'offsets' if given
+static uint64_t completeLength(const unsigned char* base, uint64_t size, std::vector<uint64_t>* offsets) {
+    uint64_t at = GameArchive::FILE_HEADER_SIZE;
+    while (at + GameArchive::RECORD_HEADER_SIZE <= size) {
+        uint64_t next = at + GameArchive::RECORD_HEADER_SIZE + read32(base + at);
+        if (next > size) break;
+        if (offsets) offsets->push_back(at);
+        at = next;
+    }
+    return at;
+}
+
+static bool truncateFile(const std::string& path, uint64_t length) {
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER at;
+    at.QuadPart = (LONGLONG)length;
+    bool ok = SetFilePointerEx(f, at, nullptr, FILE_BEGIN) && SetEndOfFile(f);
+    CloseHandle(f);
+    return ok;
+#else
+    return ::truncate(path.c_str(), (off_t)length) == 0;
+#endif
+}
+
+bool GameArchive::open(const std::string& path, std::string& error) {
+    close();
+    if (!file.open(path)) { error = "cannot open " + path; return false; }
+    if (file.size() < FILE_HEADER_SIZE || !file.map(0, (size_t)file.size())
+        || !validHeader((const unsigned char*)file.data(), file.size())) {
+        close();
+        error = path + " is not a game archive of this version";
+        return false;
+    }
+    completeLength((const unsigned char*)file.data(), file.size(), &offsets);
+    return true;
+}
+
+void GameArchive::close() {
+    file.close();
+    offsets.clear();
+}
+
+GameInfo GameArchive::info(size_t i) const {
+    const unsigned char* h = (const unsigned char*)file.data() + offsets[i];
+    GameInfo out;
+    out.plies = (uint16_t)read16(h + 4);
+    out.result = (GameResult)(h[6] & 3);
+    out.encoding = (MoveEncoding)(h[7] & ENCODING_MASK);
+    out.customStart = (h[7] & CUSTOM_START) != 0;
+    out.whiteElo = (uint16_t)read16(h + 8);
+    out.blackElo = (uint16_t)read16(h + 10);
+    out.date = read32(h + 12);
+    out.round = read32(h + 16);
+    return out;
+}
+
+bool GameArchive::read(size_t i, ArchivedGame& out) const {
+    const unsigned char* h = (const unsigned char*)file.data() + offsets[i];
+    out.info = info(i);
+    out.moves.clear();
+    uint32_t body = read32(h), fenBytes = read16(h + 20);
+    const unsigned char* p = h + RECORD_HEADER_SIZE;
+    uint32_t moveBytes = out.info.encoding == MoveEncoding::RAW16 ? 2u * out.info.plies : out.info.plies;
+    if (out.info.encoding > MoveEncoding::INDEX8 || (fenBytes != 0) != out.info.customStart || fenBytes + moveBytes != body)
+        return false;
+    if (!Notation::setFromFEN(out.start, out.info.customStart ? std::string((const char*)p, fenBytes) : Notation::START_FEN))
+        return false;
+    p += fenBytes;
+
+    Position pos = out.start;
+    MoveList legal;
+    for (int ply = 0; ply < out.info.plies; ++ply) {
+        Move m;
+        legal.clear();
+        if (out.info.encoding == MoveEncoding::RAW16) {
+            m.data = (uint16_t)read16(p + 2 * ply);
+            MoveGen::generateLegalFrom(pos, m.from(), legal);
+            if (!legal.contains(m)) return false;
+        } else {
+            MoveGen::generateLegal(pos, legal);
+            int index = p[ply];
+            if (index >= legal.size()) return false;
+            std::nth_element(legal.begin(), legal.begin() + index, legal.end(),
+                             [](const Move& a, const Move& b) { return a.data < b.data; });
+            m = legal[index];
+        }
+        out.moves.push_back(m);
+        pos.makeMove(m);
+    }
+    return true;
+}
+
+bool GameArchiveWriter::open(const std::string& path, std::string& error) {
+    close();
+    written = 0;
+    dropped = 0;
+    // An existing file must already be an archive; an empty or new one gets the header.
+    // A torn last record is cut off first: appending after it would shift every later
+    // record off the offsets the reader walks
+    uint64_t size = 0, end = 0;
+    {
+        MappedFile existing;
+        if (existing.open(path) && (size = existing.size()) > 0) {
+            if (!existing.map(0, (size_t)size) || !validHeader((const unsigned char*)existing.data(), size)) {
+                error = path + " is not a game archive of this version";
+                return false;
+            }
+            end = completeLength((const unsigned char*)existing.data(), size, nullptr);
+        }
+    }
+    if (end < size) {
+        if (!truncateFile(path, end)) { error = "cannot truncate " + path; return false; }
+        dropped = size - end;
+    }
+    out.open(path, std::ios::binary | std::ios::app);
+    if (!out) { error = "cannot write " + path; return false; }
+    if (size == 0) {
+        std::vector<unsigned char> h(GameArchive::MAGIC, GameArchive::MAGIC + sizeof(GameArchive::MAGIC));
+        put32(h, GameArchive::VERSION);
+        put32(h, 0);
+        out.write((const char*)h.data(), (std::streamsize)h.size());
+    }
+    return (bool)out;
+}
+
+void GameArchiveWriter::close() {
+    if (out.is_open()) out.close();
+}
+
+bool GameArchiveWriter::append(const Position& start, const std::vector<Move>& moves, const GameInfo& info, MoveEncoding encoding) {
+    if (!out.is_open() || moves.size() > 0xFFFF) return false;
+    std::string fen = Notation::toFEN(start);
+    if (fen == Notation::START_FEN) fen.clear();
+
+    // The record is built in memory first, so an illegal move leaves nothing written
+    record.assign(GameArchive::RECORD_HEADER_SIZE, 0);
+    record.insert(record.end(), fen.begin(), fen.end());
+    Position pos = start;
+    MoveList legal;
+    for (Move m : moves) {
+        legal.clear();
+        MoveGen::generateLegal(pos, legal);
+        if (!legal.contains(m)) return false;
+        if (encoding == MoveEncoding::RAW16) put16(record, m.data);
+        else record.push_back((unsigned char)moveIndex(legal, m));
+        pos.makeMove(m);
+    }
+
+    std::vector<unsigned char> h;
+    put32(h, (uint32_t)(record.size() - GameArchive::RECORD_HEADER_SIZE));
+    put16(h, (uint32_t)moves.size());
+    h.push_back((unsigned char)info.result);
+    h.push_back((unsigned char)((int)encoding | (fen.empty() ? 0 : CUSTOM_START)));
+    put16(h, info.whiteElo);
+    put16(h, info.blackElo);
+    put32(h, info.date);
+    put32(h, info.round);
+    put16(h, (uint32_t)fen.size());
+    put16(h, 0);
+    std::copy(h.begin(), h.end(), record.begin());
+    out.write((const char*)record.data(), (std::streamsize)record.size());
+    if (!out) return false;
+    ++written;
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Position.h"
+#include "mappedfile.h"
+
+enum class GameResult : uint8_t { UNKNOWN = 0, WHITE_WINS = 1, BLACK_WINS = 2, DRAW = 3 };
+
+// How the moves of one archived game are packed
+enum class MoveEncoding : uint8_t {
+    RAW16 = 0,  // the 16-bit Move itself (from, to, promotion, kind)
+    INDEX8 = 1  // one byte: the move's index among the legal moves sorted by Move value
+};
+
+// Fixed metadata of one game
+struct GameInfo {
+    GameResult result = GameResult::UNKNOWN;
+    uint16_t whiteElo = 0, blackElo = 0; // 0 if unknown
+    uint32_t date = 0;                   // yyyymmdd, 0 if unknown
+    uint32_t round = 0;
+    uint16_t plies = 0;                  // filled in by the writer and the reader
+    MoveEncoding encoding = MoveEncoding::RAW16;
+    bool customStart = false;            // starts from a stored FEN, not the initial position
+};
+
+struct ArchivedGame {
+    GameInfo info;
+    Position start;
+    std::vector<Move> moves;
+};
+
+// Binary game archive: the 16-byte file header "C3DGAME1" + uint32 version + uint32 0,
+// then one record per game (little-endian):
+//   uint32 body bytes, uint16 plies, uint8 result, uint8 flags (bits 0-1 encoding, bit 2
+//   custom start), uint16 white Elo, uint16 black Elo, uint32 date, uint32 round,
+//   uint16 FEN bytes, uint16 0  -- 24 bytes; then the FEN (custom starts only) and the moves
+// A typical game takes 24 + 2 bytes per ply in RAW16 or 24 + 1 in INDEX8, against several
+// hundred bytes of PGN. Records are only ever appended, so an interrupted write leaves at
+// most an incomplete last record, which the reader ignores and the writer cuts off.
+class GameArchive {
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+    static const size_t FILE_HEADER_SIZE = 16;
+    static const size_t RECORD_HEADER_SIZE = 24;
+
+    GameArchive() {}
+    GameArchive(const GameArchive&) = delete;
+    GameArchive& operator=(const GameArchive&) = delete;
+
+    // Map the whole file and index its records; false (with 'error' set) if it is not an archive
+    bool open(const std::string& path, std::string& error);
+    void close();
+    size_t size() const { return offsets.size(); }
+
+    // Header of game i, without decoding its moves
+    GameInfo info(size_t i) const;
+    // Decode game i, checking every move against the legal move generator; false if the
+    // record is corrupt. Thread-safe: any number of threads may decode at once
+    bool read(size_t i, ArchivedGame& out) const;
+
+private:
+    MappedFile file;
+    std::vector<uint64_t> offsets; // of each record header
+};
+
+// Append-only writer for the format above
+class GameArchiveWriter {
+public:
+    GameArchiveWriter() {}
+    ~GameArchiveWriter() { close(); }
+    GameArchiveWriter(const GameArchiveWriter&) = delete;
+    GameArchiveWriter& operator=(const GameArchiveWriter&) = delete;
+
+    // Create the file, or append to an existing archive after cutting off an incomplete last
+    // record; false (with 'error' set) if the file cannot be opened or holds something else
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    // Append one game; false (nothing written) if a move is illegal or it exceeds 65535 plies
+    bool append(const Position& start, const std::vector<Move>& moves, const GameInfo& info,
+                MoveEncoding encoding = MoveEncoding::INDEX8);
+    uint64_t gamesWritten() const { return written; }
+    // Bytes of an incomplete last record removed by open()
+    uint64_t bytesDropped() const { return dropped; }
+
+private:
+    std::ofstream out;
+    std::vector<unsigned char> record; // reused between games
+    uint64_t written = 0;
+    uint64_t dropped = 0;
+};
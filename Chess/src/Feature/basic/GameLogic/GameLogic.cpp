@@ -1,260 +1,257 @@
 #include "GameLogic.h"
-
-// Initialize static members
-bool GameLogic::enPassantAvailable = false;
-ChessSquare GameLogic::enPassantSquare(0, 0);
-int GameLogic::enPassantVictimIndex = -1;
+#include "MoveGen.h"
+#include "See.h"
 
 bool GameLogic::isValidSquare(int file, int rank) {
     return file >= 0 && file < 8 && rank >= 0 && rank < 8;
 }
 
-bool GameLogic::isSquareOccupied(int file, int rank, const std::vector<Piece>& pieces, int excludePiece) {
-    for(size_t i = 0; i < pieces.size(); ++i) {
-        if (i != excludePiece && pieces[i].file == file && pieces[i].rank == rank) {
-            return true;
+// Pseudo-legal destination set of the piece on 'from' (movement rules only, king safety ignored)
+static Bitboard pseudoTargets(const Position& pos, int from) {
+    bool isWhite = pos.isWhiteAt(from);
+    PieceType type = pos.typeAt(from);
+    Bitboard occ = pos.occupied();
+    Bitboard targets = 0;
+
+    if (type == PieceType::PAWN) {
+        int dir = isWhite ? 8 : -8;
+        Bitboard one = shiftBB(squareBB(from), dir) & ~occ;
+        targets |= one;
+        // a pawn still on its start rank has never moved
+        if (one && rankOf(from) == (isWhite ? 1 : 6)) targets |= shiftBB(one, dir) & ~occ;
+        // captures
+        Bitboard captures = pawnAttacksBB(squareBB(from), isWhite);
+        targets |= captures & pos.pieces(!isWhite);
+        // en-passant (only the side to move may take it)
+        if (pos.enPassantSquare() >= 0 && isWhite == pos.whiteToMove()) targets |= captures & squareBB(pos.enPassantSquare());
+    } else {
+        targets = pos.attacksFrom(from, occ) & ~pos.pieces(isWhite);
+        // castling (simplified; ignores check)
+        if (type == PieceType::KING && from == (isWhite ? 4 : 60)) {
+            uint8_t rights = pos.castlingRights();
+            auto empty = [&](int a, int b) { for (int sq = a; sq <= b; ++sq) if (!pos.isEmpty(sq)) return false; return true; };
+            if ((rights & (isWhite ? WHITE_OO : BLACK_OO)) && empty(from + 1, from + 2))
+                targets |= squareBB(from + 2);
+            if ((rights & (isWhite ? WHITE_OOO : BLACK_OOO)) && empty(from - 3, from - 1))
+                targets |= squareBB(from - 2);
         }
     }
-    return false;
+    return targets;
 }
 
-bool GameLogic::isSquareOccupiedByEnemy(int file, int rank, bool isWhite, const std::vector<Piece>& pieces, int excludePiece) {
-    for(size_t i = 0; i < pieces.size(); ++i) {
-        if (i != excludePiece && pieces[i].file == file && pieces[i].rank == rank && pieces[i].isWhite != isWhite) {
-            return true;
-        }
+// Encode a from/to pair as a Move, detecting castling, en-passant and promotion
+static Move encodeMove(const Position& pos, int from, int to, PieceType promotion = PieceType::QUEEN) {
+    PieceType t = pos.typeAt(from);
+    if (t == PieceType::KING && (to - from == 2 || from - to == 2)) return Move(from, to, MoveKind::CASTLING);
+    if (t == PieceType::PAWN) {
+        if (to == pos.enPassantSquare()) return Move(from, to, MoveKind::EN_PASSANT);
+        if (rankOf(to) == 0 || rankOf(to) == 7) return Move(from, to, MoveKind::PROMOTION, promotion);
     }
-    return false;
+    return Move(from, to);
 }
 
-std::vector<ChessSquare> GameLogic::getAllowableMoves(int pieceIndex, const std::vector<Piece>& pieces) {
-    std::vector<ChessSquare> allowableMoves;
+// Let 'white' move in a scratch copy; the en-passant target belongs to the real side to move
+static void moveAs(Position& pos, bool white) {
+    if (pos.whiteToMove() == white) return;
+    pos.setWhiteToMove(white);
+    pos.setEnPassantSquare(-1);
+}
 
-    if (pieceIndex < 0 || pieceIndex >= pieces.size()) return allowableMoves;
+// Square index of a scene square, -1 if off the board
+static int boardSquare(ChessSquare s) {
+    return GameLogic::isValidSquare(s.file, s.rank) ? squareOf(s.file, s.rank) : -1;
+}
 
-    const Piece& piece = pieces[pieceIndex];
-    int currentFile = piece.file;
-    int currentRank = piece.rank;
-    bool isWhite = piece.isWhite;
+bool GameLogic::isSquareOccupied(const Position& pos, int file, int rank) {
+    return isValidSquare(file, rank) && !pos.isEmpty(squareOf(file, rank));
+}
 
-    auto squareOccupiedByFriend = [&](int nf, int nr){
-        for (const auto& p : pieces) if (p.file == nf && p.rank == nr) return p.isWhite == isWhite; return false;
-    };
-    auto squareOccupiedByEnemy = [&](int nf, int nr){
-        for (const auto& p : pieces) if (p.file == nf && p.rank == nr) return p.isWhite != isWhite; return false;
-    };
+bool GameLogic::isSquareOccupiedByEnemy(const Position& pos, int file, int rank, bool isWhite) {
+    if (!isSquareOccupied(pos, file, rank)) return false;
+    return pos.isWhiteAt(squareOf(file, rank)) != isWhite;
+}
 
-    switch (piece.type) {
-        case PieceType::PAWN: {
-            int dir = isWhite ? 1 : -1;
-            int one = currentRank + dir;
-            if (isValidSquare(currentFile, one) && !isSquareOccupied(currentFile, one, pieces)) {
-                allowableMoves.push_back(ChessSquare(currentFile, one));
-                if (!piece.hasMoved) {
-                    int two = currentRank + 2 * dir;
-                    if (isValidSquare(currentFile, two) && !isSquareOccupied(currentFile, two, pieces)) 
-                        allowableMoves.push_back(ChessSquare(currentFile, two));
-                }
-            }
-            // captures
-            for (int df : {-1, 1}) {
-                int nf = currentFile + df; int nr = currentRank + dir;
-                if (!isValidSquare(nf, nr)) continue;
-                if (squareOccupiedByEnemy(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr));
-            }
-            // en-passant
-            if (enPassantAvailable) {
-                for (int df : {-1, 1}) {
-                    int nf = currentFile + df; int nr = currentRank + dir;
-                    if (nf == enPassantSquare.file && nr == enPassantSquare.rank) 
-                        allowableMoves.push_back(enPassantSquare);
-                }
-            }
-            break;
-        }
-        case PieceType::ROOK: {
-            auto addLine = [&](int sf, int sr){
-                for (int s = 1; s < 8; ++s) {
-                    int nf = currentFile + s*sf, nr = currentRank + s*sr;
-                    if (!isValidSquare(nf, nr)) break;
-                    if (!isSquareOccupied(nf, nr, pieces)) allowableMoves.push_back(ChessSquare(nf, nr));
-                    else { if (squareOccupiedByEnemy(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr)); break; }
-                }
-            };
-            addLine(1,0); addLine(-1,0); addLine(0,1); addLine(0,-1);
-            break;
-        }
-        case PieceType::BISHOP: {
-            auto addLine = [&](int sf, int sr){
-                for (int s = 1; s < 8; ++s) {
-                    int nf = currentFile + s*sf, nr = currentRank + s*sr;
-                    if (!isValidSquare(nf, nr)) break;
-                    if (!isSquareOccupied(nf, nr, pieces)) allowableMoves.push_back(ChessSquare(nf, nr));
-                    else { if (squareOccupiedByEnemy(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr)); break; }
-                }
-            };
-            addLine(1,1); addLine(1,-1); addLine(-1,1); addLine(-1,-1);
-            break;
-        }
-        case PieceType::QUEEN: {
-            auto addLine = [&](int sf, int sr){
-                for (int s = 1; s < 8; ++s) {
-                    int nf = currentFile + s*sf, nr = currentRank + s*sr;
-                    if (!isValidSquare(nf, nr)) break;
-                    if (!isSquareOccupied(nf, nr, pieces)) allowableMoves.push_back(ChessSquare(nf, nr));
-                    else { if (squareOccupiedByEnemy(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr)); break; }
-                }
-            };
-            addLine(1,0); addLine(-1,0); addLine(0,1); addLine(0,-1);
-            addLine(1,1); addLine(1,-1); addLine(-1,1); addLine(-1,-1);
-            break;
-        }
-        case PieceType::KNIGHT: {
-            int moves[8][2] = {{-2,-1},{-2,1},{-1,-2},{-1,2},{1,-2},{1,2},{2,-1},{2,1}};
-            for (auto &m : moves) {
-                int nf = currentFile + m[0], nr = currentRank + m[1];
-                if (!isValidSquare(nf, nr)) continue;
-                if (!squareOccupiedByFriend(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr));
-            }
-            break;
-        }
-        case PieceType::KING: {
-            for (int df = -1; df <= 1; ++df) for (int dr = -1; dr <= 1; ++dr) {
-                if (df == 0 && dr == 0) continue;
-                int nf = currentFile + df, nr = currentRank + dr;
-                if (!isValidSquare(nf, nr)) continue;
-                if (!squareOccupiedByFriend(nf, nr)) allowableMoves.push_back(ChessSquare(nf, nr));
-            }
-            // castling (simplified; ignores check)
-            if (!piece.hasMoved) {
-                // king side
-                int rf = 7; int rr = currentRank; int rookIdx = -1;
-                for (int i=0;i<(int)pieces.size();++i) if (pieces[i].type==PieceType::ROOK && pieces[i].isWhite==isWhite && pieces[i].rank==rr && pieces[i].file==rf) { rookIdx = i; break; }
-                if (rookIdx>=0 && !pieces[rookIdx].hasMoved && !isSquareOccupied(currentFile+1, rr, pieces) && !isSquareOccupied(currentFile+2, rr, pieces))
-                    allowableMoves.push_back(ChessSquare(currentFile+2, rr));
-                // queen side
-                rf = 0; rr = currentRank; rookIdx = -1;
-                for (int i=0;i<(int)pieces.size();++i) if (pieces[i].type==PieceType::ROOK && pieces[i].isWhite==isWhite && pieces[i].rank==rr && pieces[i].file==rf) { rookIdx = i; break; }
-                if (rookIdx>=0 && !pieces[rookIdx].hasMoved && !isSquareOccupied(currentFile-1, rr, pieces) && !isSquareOccupied(currentFile-2, rr, pieces) && !isSquareOccupied(currentFile-3, rr, pieces))
-                    allowableMoves.push_back(ChessSquare(currentFile-2, rr));
-            }
-            break;
-        }
-    }
+void GameLogic::getAllowableMoves(const Position& pos, ChessSquare from, MoveList& out) {
+    int sq = boardSquare(from);
+    if (sq < 0 || pos.isEmpty(sq)) return;
+    Bitboard targets = pseudoTargets(pos, sq);
+    while (targets) out.push_back(encodeMove(pos, sq, popLsb(targets)));
+}
 
-    return allowableMoves;
+bool GameLogic::isValidMove(const Position& pos, ChessSquare from, ChessSquare to) {
+    int fromSq = boardSquare(from), toSq = boardSquare(to);
+    if (fromSq < 0 || toSq < 0 || pos.isEmpty(fromSq)) return false;
+    return (pseudoTargets(pos, fromSq) & squareBB(toSq)) != 0;
 }
 
-bool GameLogic::isValidMove(int pieceIndex, int targetFile, int targetRank, const std::vector<Piece>& pieces) {
-    if (!isValidSquare(targetFile, targetRank)) return false;
-    const std::vector<ChessSquare> allowableMoves = getAllowableMoves(pieceIndex, pieces);
-    for (const ChessSquare& m : allowableMoves) {
-        if (m.file == targetFile && m.rank == targetRank) return true;
-    }
-    return false;
+bool GameLogic::isSquareAttacked(const Position& pos, int f, int r, bool byWhite) {
+    if (!isValidSquare(f, r)) return false;
+    return pos.isSquareAttacked(squareOf(f, r), byWhite);
 }
 
-void GameLogic::markCaptured(std::vector<Piece>& pieces, int idx) {
-    if (idx < 0 || idx >= (int)pieces.size()) return;
-    pieces[idx].file = -999;
-    pieces[idx].rank = -999;
-    pieces[idx].model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -10.0f, 0.0f));
+bool GameLogic::isSideInCheck(const Position& pos, bool sideIsWhite) {
+    return pos.inCheck(sideIsWhite);
 }
 
-int GameLogic::findKingIndex(const std::vector<Piece>& pcs, bool isWhite) {
-    for (int i=0;i<(int)pcs.size();++i) if (pcs[i].type==PieceType::KING && pcs[i].file>=0 && pcs[i].rank>=0 && pcs[i].isWhite==isWhite) return i;
-    return -1;
+bool GameLogic::canCommitMove(const Position& pos, ChessSquare from, ChessSquare to) {
+    int fromSq = boardSquare(from);
+    if (fromSq < 0 || pos.isEmpty(fromSq) || pos.isWhiteAt(fromSq) != pos.whiteToMove()) return false;
+    // Final legality check including king safety and special cases
+    return wouldBeLegalMove(pos, from, to);
 }
 
-static bool squareOccupied(const std::vector<Piece>& pcs, int f, int r) {
-    for (auto& p: pcs) if (p.file==f && p.rank==r) return true; return false;
+bool GameLogic::wouldBeLegalMove(const Position& pos, ChessSquare from, ChessSquare to) {
+    int fromSq = boardSquare(from), toSq = boardSquare(to);
+    if (fromSq < 0 || toSq < 0 || pos.isEmpty(fromSq)) return false;
+    // First ensure the move obeys the piece's movement rules (pseudo-legal)
+    if (!(pseudoTargets(pos, fromSq) & squareBB(toSq))) return false;
+    bool mover = pos.isWhiteAt(fromSq);
+    int king = pos.kingSquare(mover);
+    if (king < 0) return false;
+    Bitboard enemies = pos.pieces(!mover);
+    if (pos.typeAt(fromSq) == PieceType::KING) {
+        // Castling out of or through check: read from the attack maps when pos tracks them
+        if (toSq - fromSq == 2 || fromSq - toSq == 2)
+            return !pos.isSquareAttacked(fromSq, !mover) && !pos.isSquareAttacked((fromSq + toSq) / 2, !mover)
+                && !pos.isSquareAttacked(toSq, !mover);
+        // The king's own square is vacated so sliders see through it
+        return !(pos.attackersTo(toSq, pos.occupied() ^ squareBB(fromSq)) & enemies & ~squareBB(toSq));
+    }
+    // Other moves: the king must not be attacked on the board after the move. Occupancy is
+    // patched in place of a make/unmake on a copy; a captured piece no longer attacks
+    bool enPassant = pos.typeAt(fromSq) == PieceType::PAWN && toSq == pos.enPassantSquare() && mover == pos.whiteToMove();
+    int capSq = enPassant ? toSq + (mover ? -8 : 8) : toSq;
+    Bitboard occ = (pos.occupied() ^ squareBB(fromSq) ^ squareBB(capSq)) | squareBB(toSq);
+    return !(pos.attackersTo(king, occ) & enemies & ~squareBB(capSq));
 }
 
-bool GameLogic::isSquareAttacked(const std::vector<Piece>& pcs, int f, int r, bool byWhite) {
-    // Pawns
-    int dir = byWhite ? 1 : -1;
-    for (auto& p: pcs) {
-        if (p.file<0||p.rank<0||p.isWhite!=byWhite) continue;
-        switch (p.type) {
-            case PieceType::PAWN: {
-                if ((p.file+1==f && p.rank+dir==r) || (p.file-1==f && p.rank+dir==r)) return true; break;
-            }
-            case PieceType::KNIGHT: {
-                int mv[8][2]={{-2,-1},{-2,1},{-1,-2},{-1,2},{1,-2},{1,2},{2,-1},{2,1}}; for (auto&m:mv){ if (p.file+m[0]==f && p.rank+m[1]==r) return true; } break;
-            }
-            case PieceType::BISHOP: case PieceType::ROOK: case PieceType::QUEEN: {
-                auto ray=[&](int sf,int sr){ for(int s=1;s<8;++s){int nf=p.file+s*sf,nr=p.rank+s*sr; if(nf<0||nf>7||nr<0||nr>7) break; if(nf==f&&nr==r) return true; if(squareOccupied(pcs,nf,nr)) break;} return false;};
-                if (p.type==PieceType::BISHOP||p.type==PieceType::QUEEN){ if(ray(1,1)||ray(1,-1)||ray(-1,1)||ray(-1,-1)) return true; }
-                if (p.type==PieceType::ROOK||p.type==PieceType::QUEEN){ if(ray(1,0)||ray(-1,0)||ray(0,1)||ray(0,-1)) return true; }
-                break;
-            }
-            case PieceType::KING: {
-                for(int df=-1;df<=1;++df)for(int dr=-1;dr<=1;++dr){ if(df==0&&dr==0)continue; if(p.file+df==f&&p.rank+dr==r) return true; } break;
-            }
-        }
+Move GameLogic::findLegalMove(const Position& pos, ChessSquare from, ChessSquare to, PieceType promotion) {
+    int fromSq = boardSquare(from), toSq = boardSquare(to);
+    if (fromSq < 0 || toSq < 0) return Move();
+    MoveList moves;
+    MoveGen::generateLegalFrom(pos, fromSq, moves);
+    for (const Move& m : moves) {
+        if (m.to() != toSq) continue;
+        if (m.kind() == MoveKind::PROMOTION && m.promotion() != promotion) continue;
+        return m;
     }
-    return false;
+    return Move();
 }
 
-bool GameLogic::isSideInCheck(const std::vector<Piece>& pcs, bool sideIsWhite) {
-    int k = findKingIndex(pcs, sideIsWhite);
-    if (k < 0) return false;
-    return isSquareAttacked(pcs, pcs[k].file, pcs[k].rank, !sideIsWhite);
+void GameLogic::getLegalMovesConsideringCheck(const Position& posIn, ChessSquare from, MoveList& out) {
+    int sq = boardSquare(from);
+    if (sq < 0 || posIn.isEmpty(sq)) return;
+    Position pos = posIn;
+    moveAs(pos, pos.isWhiteAt(sq));
+    MoveGen::generateLegalFrom(pos, sq, out);
 }
 
-bool GameLogic::canCommitMove(const std::vector<Piece>& pcs, int moverIdx, ChessSquare from, ChessSquare to, bool sideToMove) {
-    if (moverIdx < 0 || moverIdx >= (int)pcs.size()) return false;
-    if (pcs[moverIdx].isWhite != sideToMove) return false;
-    // Final legality check including king safety and special cases
-    return wouldBeLegalMove(pcs, moverIdx, from, to, enPassantAvailable, enPassantSquare);
+Bitboard GameStatus::targetsFrom(int file, int rank) const {
+    return GameLogic::isValidSquare(file, rank) ? targets[squareOf(file, rank)] : 0;
 }
 
-bool GameLogic::wouldBeLegalMove(const std::vector<Piece>& piecesIn, int moverIdx, ChessSquare from, ChessSquare to, bool enPassAvail, ChessSquare enPassSq) {
-    std::vector<Piece> pcs = piecesIn; if (moverIdx<0||moverIdx>=(int)pcs.size()) return false; Piece& m = pcs[moverIdx]; bool side=m.isWhite;
-    // First ensure the move obeys the piece's movement rules (pseudo-legal)
-    {
-        const std::vector<ChessSquare> pseudo = getAllowableMoves(moverIdx, piecesIn);
-        bool found = false; for (const auto& mv : pseudo) if (mv.file==to.file && mv.rank==to.rank) { found = true; break; }
-        if (!found) return false;
-    }
-    // capture target or en-passant victim
-    int captured=-1;
-    for (int i=0;i<(int)pcs.size();++i) if (i!=moverIdx && pcs[i].file==to.file && pcs[i].rank==to.rank && pcs[i].isWhite!=side) { captured=i; break; }
-    if (m.type==PieceType::PAWN && enPassAvail && to.file==enPassSq.file && to.rank==enPassSq.rank) {
-        int dir = side?1:-1; int victimRank = to.rank - dir; for (int i=0;i<(int)pcs.size();++i) if (pcs[i].file==to.file && pcs[i].rank==victimRank && pcs[i].type==PieceType::PAWN && pcs[i].isWhite!=side) { captured=i; break; }
+bool GameStatus::isLegalTarget(int fromFile, int fromRank, int toFile, int toRank) const {
+    if (!GameLogic::isValidSquare(toFile, toRank)) return false;
+    return (targetsFrom(fromFile, fromRank) & squareBB(squareOf(toFile, toRank))) != 0;
+}
+
+Move GameStatus::findMove(int fromFile, int fromRank, int toFile, int toRank, PieceType promotion) const {
+    if (!isLegalTarget(fromFile, fromRank, toFile, toRank)) return Move();
+    int from = squareOf(fromFile, fromRank), to = squareOf(toFile, toRank);
+    for (const Move& m : legal[whiteToMove ? 0 : 1]) {
+        if (m.from() != from || m.to() != to) continue;
+        if (m.kind() == MoveKind::PROMOTION && m.promotion() != promotion) continue;
+        return m;
     }
-    if (captured>=0) { pcs[captured].file=-999; pcs[captured].rank=-999; }
-    // castling rook move in simulation
-    if (m.type==PieceType::KING && abs(to.file-from.file)==2) {
-        // Additional rules: king cannot castle out of, through, or into check
-        // 1) current square not attacked
-        if (isSquareAttacked(piecesIn, from.file, from.rank, !side)) return false;
-        // 2) square it passes through not attacked
-        int step = (to.file>from.file)? 1 : -1; int midFile = from.file + step;
-        if (isSquareAttacked(piecesIn, midFile, from.rank, !side)) return false;
-        int rr = from.rank; if (to.file>from.file) { // king side
-            for(int i=0;i<(int)pcs.size();++i) if(pcs[i].type==PieceType::ROOK && pcs[i].isWhite==side && pcs[i].rank==rr && pcs[i].file==7) { pcs[i].file=5; break; }
-        } else { // queen side
-            for(int i=0;i<(int)pcs.size();++i) if(pcs[i].type==PieceType::ROOK && pcs[i].isWhite==side && pcs[i].rank==rr && pcs[i].file==0) { pcs[i].file=3; break; }
+    return Move();
+}
+
+CaptureKind GameStatus::captureKind(int fromFile, int fromRank, int toFile, int toRank) const {
+    if (!GameLogic::isValidSquare(fromFile, fromRank) || !GameLogic::isValidSquare(toFile, toRank)) return CaptureKind::NONE;
+    int from = squareOf(fromFile, fromRank);
+    Bitboard to = squareBB(squareOf(toFile, toRank));
+    if (!(captures[from] & to)) return CaptureKind::NONE;
+    if (winningCaptures[from] & to) return CaptureKind::WINNING;
+    return (losingCaptures[from] & to) ? CaptureKind::LOSING : CaptureKind::EQUAL;
+}
+
+// Squares attacked by one side: the tracked maps when pos keeps them, else one pass over its pieces
+static Bitboard attackedSquares(const Position& pos, bool byWhite) {
+    if (pos.attackTracking()) return pos.attackedBy(byWhite);
+    Bitboard attacked = 0;
+    for (Bitboard b = pos.pieces(byWhite); b; ) attacked |= pos.attacksFrom(popLsb(b), pos.occupied());
+    return attacked;
+}
+
+void GameLogic::computeStatus(const Position& posIn, GameStatus& status, const Tablebase* tb) {
+    // The generator works on an untracked scratch copy (it never reads the maps); check flags
+    // and attacked squares come from posIn, whose maps the game keeps up to date move by move
+    Position pos = posIn;
+    pos.setAttackTracking(false);
+    bool whitesTurn = pos.whiteToMove();
+    status.whiteToMove = whitesTurn;
+    for (int sq = 0; sq < 64; ++sq) status.targets[sq] = status.captures[sq] = status.winningCaptures[sq] = status.losingCaptures[sq] = 0;
+    // One generator run per color instead of one position build per piece
+    for (int k = 0; k < 2; ++k) {
+        int c = (k == 0) == whitesTurn ? 0 : 1; // side to move first, while the ep target still stands
+        moveAs(pos, c == 0);
+        status.legal[c].clear();
+        MoveGen::generateLegal(pos, status.legal[c]);
+        // Promotions collapse onto one destination bit, matching the auto-queen UI
+        for (const Move& m : status.legal[c]) {
+            status.targets[m.from()] |= squareBB(m.to());
+            bool capture = m.kind() == MoveKind::EN_PASSANT || (m.kind() != MoveKind::CASTLING && !pos.isEmpty(m.to()));
+            if (!capture || (m.kind() == MoveKind::PROMOTION && m.promotion() != PieceType::QUEEN)) continue;
+            status.captures[m.from()] |= squareBB(m.to());
+            int gain = See::value(pos, m);
+            if (gain > 0) status.winningCaptures[m.from()] |= squareBB(m.to());
+            else if (gain < 0) status.losingCaptures[m.from()] |= squareBB(m.to());
         }
     }
-    // move king/piece
-    pcs[moverIdx].file=to.file; pcs[moverIdx].rank=to.rank;
-    int kingIdx = findKingIndex(pcs, side);
-    if (kingIdx<0) return false;
-    return !isSquareAttacked(pcs, pcs[kingIdx].file, pcs[kingIdx].rank, !side);
+    bool hasMoves[2] = { !status.legal[0].empty(), !status.legal[1].empty() };
+    status.attacked[0] = attackedSquares(posIn, true);
+    status.attacked[1] = attackedSquares(posIn, false);
+    status.whiteInCheck = posIn.inCheck(true);
+    status.blackInCheck = posIn.inCheck(false);
+    status.whiteCheckmate = status.whiteInCheck && !hasMoves[0];
+    status.blackCheckmate = status.blackInCheck && !hasMoves[1];
+    bool sideInCheck = whitesTurn ? status.whiteInCheck : status.blackInCheck;
+    status.stalemate = !status.whiteCheckmate && !status.blackCheckmate && !sideInCheck && !hasMoves[whitesTurn ? 0 : 1];
+    status.tablebase = TbResult();
+    status.tablebaseHit = tb && tb->probe(posIn, status.tablebase);
 }
 
-std::vector<ChessSquare> GameLogic::getLegalMovesConsideringCheck(int pieceIndex, const std::vector<Piece>& pcs) {
-    std::vector<ChessSquare> legals;
-    if (pieceIndex < 0 || pieceIndex >= (int)pcs.size()) return legals;
-    const Piece& p = pcs[pieceIndex];
-    auto pseudo = getAllowableMoves(pieceIndex, pcs);
-    ChessSquare from(p.file, p.rank);
-    for (const auto& mv : pseudo) {
-        if (wouldBeLegalMove(pcs, pieceIndex, from, mv, enPassantAvailable, enPassantSquare)) legals.push_back(mv);
+bool GameLogic::isLegalPosition(const Position& pos, std::string* reason) {
+    auto fail = [&](const char* why) { if (reason) *reason = why; return false; };
+    for (int c = 0; c < 2; ++c) {
+        bool white = c == 0;
+        if (popCount(pos.pieces(white, PieceType::KING)) != 1) return fail("each side needs exactly one king");
+        if (popCount(pos.pieces(white)) > 16) return fail("more than 16 pieces on one side");
+        if (popCount(pos.pieces(white, PieceType::PAWN)) > 8) return fail("more than 8 pawns on one side");
+    }
+    Bitboard backRanks = 0xFF000000000000FFULL;
+    if ((pos.pieces(true, PieceType::PAWN) | pos.pieces(false, PieceType::PAWN)) & backRanks)
+        return fail("pawn on the first or last rank");
+    if (pos.inCheck(!pos.whiteToMove())) return fail("side not to move is in check");
+
+    uint8_t rights = pos.castlingRights();
+    auto holds = [&](int sq, PieceType t, bool white) {
+        return !pos.isEmpty(sq) && pos.typeAt(sq) == t && pos.isWhiteAt(sq) == white;
+    };
+    if ((rights & (WHITE_OO | WHITE_OOO)) && !holds(4, PieceType::KING, true)) return fail("castling rights without the king on e1");
+    if ((rights & (BLACK_OO | BLACK_OOO)) && !holds(60, PieceType::KING, false)) return fail("castling rights without the king on e8");
+    if (((rights & WHITE_OO) && !holds(7, PieceType::ROOK, true)) || ((rights & WHITE_OOO) && !holds(0, PieceType::ROOK, true))
+        || ((rights & BLACK_OO) && !holds(63, PieceType::ROOK, false)) || ((rights & BLACK_OOO) && !holds(56, PieceType::ROOK, false)))
+        return fail("castling rights without the rook on its home square");
+
+    int ep = pos.enPassantSquare();
+    if (ep >= 0) {
+        bool white = pos.whiteToMove();
+        int behind = white ? ep + 8 : ep - 8, pawn = white ? ep - 8 : ep + 8;
+        if (rankOf(ep) != (white ? 5 : 2) || !pos.isEmpty(ep) || !pos.isEmpty(behind) || !holds(pawn, PieceType::PAWN, !white))
+            return fail("en-passant square without a pawn that just double-pushed");
     }
-    return legals;
+    return true;
 }
 
 ChessSquare GameLogic::notationToSquare(const std::string& notation) {
@@ -1,44 +1,79 @@
 #pragma once
 
-#include <vector>
 #include <string>
-#include <glm/glm.hpp>
-#include "Types.h"
+#include "CoreTypes.h"
+#include "Position.h"
+#include "MoveList.h"
+#include "Tablebase.h"
 
-// Chess game logic system extracted from main.cpp
+// Outcome of a capture by static exchange evaluation
+enum class CaptureKind { NONE, WINNING, EQUAL, LOSING };
+
+// Rules state of one board position, rebuilt by GameLogic::computeStatus only when
+// the board changes so per-frame code can read it without touching move generation
+struct GameStatus {
+    bool whiteToMove = true;
+    bool whiteInCheck = false, blackInCheck = false;
+    bool whiteCheckmate = false, blackCheckmate = false;
+    bool stalemate = false;   // side to move is not in check and has no legal move
+    Bitboard attacked[2] = { 0, 0 };  // squares attacked by White [0] and Black [1]
+    MoveList legal[2];        // every legal move of White [0] and Black [1]
+    Bitboard targets[64];     // legal destinations of the piece standing on each square
+    Bitboard captures[64];    // legal capture destinations per square (promotions as queen)
+    Bitboard winningCaptures[64], losingCaptures[64]; // by exchange value; the rest trade evenly
+    bool tablebaseHit = false; // 'tablebase' holds the exact value for the side to move
+    TbResult tablebase;
+
+    // Destinations of the piece on (file, rank); empty for off-board squares
+    Bitboard targetsFrom(int file, int rank) const;
+    bool isLegalTarget(int fromFile, int fromRank, int toFile, int toRank) const;
+    // The side to move's legal move from -> to, resolved from the stored list; none if
+    // there is no such move (same contract as GameLogic::findLegalMove)
+    Move findMove(int fromFile, int fromRank, int toFile, int toRank, PieceType promotion = PieceType::QUEEN) const;
+    // NONE unless from -> to is a legal capture
+    CaptureKind captureKind(int fromFile, int fromRank, int toFile, int toRank) const;
+};
+
+// Chess game logic system extracted from main.cpp (part of the headless ChessCore
+// library; scene pieces are bridged in BoardSync). Every rules query is a pure function
+// of a Position (placement, side to move, castling, en passant, move counters); there is
+// no shared state, so any number of games or lines can be evaluated on parallel threads.
 class GameLogic {
 public:
     // Board validation
     static bool isValidSquare(int file, int rank);
     
     // Square occupation checks
-    static bool isSquareOccupied(int file, int rank, const std::vector<Piece>& pieces, int excludePiece = -1);
-    static bool isSquareOccupiedByEnemy(int file, int rank, bool isWhite, const std::vector<Piece>& pieces, int excludePiece = -1);
+    static bool isSquareOccupied(const Position& pos, int file, int rank);
+    static bool isSquareOccupiedByEnemy(const Position& pos, int file, int rank, bool isWhite);
     
-    // Move generation
-    static std::vector<ChessSquare> getAllowableMoves(int pieceIndex, const std::vector<Piece>& pieces);
-    static std::vector<ChessSquare> getLegalMovesConsideringCheck(int pieceIndex, const std::vector<Piece>& pieces);
+    // Move generation for the piece on 'from' (appends to 'out'; pseudo-legal and fully legal respectively)
+    static void getAllowableMoves(const Position& pos, ChessSquare from, MoveList& out);
+    static void getLegalMovesConsideringCheck(const Position& pos, ChessSquare from, MoveList& out);
     
-    // Move validation
-    static bool isValidMove(int pieceIndex, int targetFile, int targetRank, const std::vector<Piece>& pieces);
-    static bool canCommitMove(const std::vector<Piece>& pcs, int moverIdx, ChessSquare from, ChessSquare to, bool sideToMove);
-    static bool wouldBeLegalMove(const std::vector<Piece>& piecesIn, int moverIdx, ChessSquare from, ChessSquare to, bool enPassAvail, ChessSquare enPassSq);
+    // Move validation (the mover is whatever piece stands on 'from')
+    static bool isValidMove(const Position& pos, ChessSquare from, ChessSquare to);
+    static bool canCommitMove(const Position& pos, ChessSquare from, ChessSquare to); // side to move only
+    static bool wouldBeLegalMove(const Position& pos, ChessSquare from, ChessSquare to);
+    // The side to move's legal move from -> to; none if there is no such move
+    static Move findLegalMove(const Position& pos, ChessSquare from, ChessSquare to, PieceType promotion = PieceType::QUEEN);
     
+    // Whether pos can arise in a game: one king per side, no pawns on the back ranks, at most
+    // 16 men and 8 pawns per side, side not to move not in check, castling rights backed by
+    // unmoved king and rook, and an en-passant target behind a pawn that just double-pushed.
+    // On failure 'reason' (when given) names the first rule broken
+    static bool isLegalPosition(const Position& pos, std::string* reason = nullptr);
+
+    // Check flags, mate/stalemate, every piece's legal moves and the exchange value of every
+    // capture in one pass; with 'tb' the tablebase value too, when the material is covered
+    static void computeStatus(const Position& pos, GameStatus& status, const Tablebase* tb = nullptr);
+
     // Check detection
-    static bool isSideInCheck(const std::vector<Piece>& pcs, bool sideIsWhite);
-    static bool isSquareAttacked(const std::vector<Piece>& pcs, int f, int r, bool byWhite);
-    static int findKingIndex(const std::vector<Piece>& pcs, bool isWhite);
-    
-    // Piece management
-    static void markCaptured(std::vector<Piece>& pieces, int idx);
+    static bool isSideInCheck(const Position& pos, bool sideIsWhite);
+    static bool isSquareAttacked(const Position& pos, int f, int r, bool byWhite);
     
     // Utility functions
     static ChessSquare notationToSquare(const std::string& notation);
     static int squareToPieceIndex(const ChessSquare& square);
     static ChessSquare pieceIndexToSquare(int pieceIndex);
-    
-    // En-passant state (externally managed)
-    static bool enPassantAvailable;
-    static ChessSquare enPassantSquare;
-    static int enPassantVictimIndex;
 };
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include "CoreTypes.h"
+
+// Special move kinds (stored in the top two bits of a Move)
+enum class MoveKind : uint8_t {
+    NORMAL = 0,
+    PROMOTION = 1,
+    EN_PASSANT = 2,
+    CASTLING = 3     // encoded as the king's two-square move
+};
+
+// Compact 16-bit move: bits 0-5 from, 6-11 to, 12-13 promotion piece, 14-15 kind
+struct Move {
+    uint16_t data;
+
+    Move() : data(0) {}
+    Move(int from, int to, MoveKind kind = MoveKind::NORMAL, PieceType promotion = PieceType::KNIGHT)
+        : data((uint16_t)(from | (to << 6) | (promoCode(promotion) << 12) | ((int)kind << 14))) {}
+
+    int from() const { return data & 63; }
+    int to() const { return (data >> 6) & 63; }
+    MoveKind kind() const { return (MoveKind)(data >> 14); }
+    PieceType promotion() const {
+        static const PieceType types[4] = { PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN };
+        return types[(data >> 12) & 3];
+    }
+    bool isNone() const { return data == 0; }
+
+    bool operator==(const Move& o) const { return data == o.data; }
+    bool operator!=(const Move& o) const { return data != o.data; }
+
+private:
+    static int promoCode(PieceType t) {
+        switch (t) {
+            case PieceType::BISHOP: return 1;
+            case PieceType::ROOK:   return 2;
+            case PieceType::QUEEN:  return 3;
+            default:                return 0;
+        }
+    }
+};
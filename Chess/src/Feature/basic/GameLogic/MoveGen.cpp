@@ -0,0 +1,127 @@
+#include "MoveGen.h"
+#include "Attacks.h"
+
+static void addPromotions(MoveList& moves, int from, int to) {
+    moves.push_back(Move(from, to, MoveKind::PROMOTION, PieceType::QUEEN));
+    moves.push_back(Move(from, to, MoveKind::PROMOTION, PieceType::ROOK));
+    moves.push_back(Move(from, to, MoveKind::PROMOTION, PieceType::BISHOP));
+    moves.push_back(Move(from, to, MoveKind::PROMOTION, PieceType::KNIGHT));
+}
+
+void MoveGen::generateLegal(const Position& pos, MoveList& moves) {
+    generate(pos, ~0ULL, moves);
+}
+
+void MoveGen::generateLegalFrom(const Position& pos, int from, MoveList& moves) {
+    if (from < 0 || from >= 64) return;
+    generate(pos, squareBB(from), moves);
+}
+
+Bitboard MoveGen::checkers(const Position& pos) {
+    bool us = pos.whiteToMove();
+    int ksq = pos.kingSquare(us);
+    if (ksq < 0) return 0;
+    return pos.attackersTo(ksq, pos.occupied()) & pos.pieces(!us);
+}
+
+Bitboard MoveGen::pinnedPieces(const Position& pos, bool isWhite) {
+    int ksq = pos.kingSquare(isWhite);
+    if (ksq < 0) return 0;
+    Bitboard queens = pos.pieces(PieceType::QUEEN);
+    // Enemy sliders that would hit the king on an empty board
+    Bitboard snipers = ((Attacks::rook(ksq, 0) & (pos.pieces(PieceType::ROOK) | queens))
+                      | (Attacks::bishop(ksq, 0) & (pos.pieces(PieceType::BISHOP) | queens))) & pos.pieces(!isWhite);
+    Bitboard pinned = 0;
+    while (snipers) {
+        int s = popLsb(snipers);
+        Bitboard between = Attacks::between(ksq, s) & pos.occupied();
+        if (between && !(between & (between - 1))) pinned |= between & pos.pieces(isWhite);
+    }
+    return pinned;
+}
+
+void MoveGen::generate(const Position& pos, Bitboard fromMask, MoveList& moves) {
+    bool us = pos.whiteToMove();
+    int ksq = pos.kingSquare(us);
+    if (ksq < 0) return;
+
+    Bitboard occ = pos.occupied();
+    Bitboard own = pos.pieces(us), enemy = pos.pieces(!us);
+    Bitboard chk = pos.attackersTo(ksq, occ) & enemy;
+
+    // King: destinations must be safe with the king lifted off its square (no x-ray retreats)
+    if (fromMask & squareBB(ksq)) {
+        Bitboard occNoKing = occ ^ squareBB(ksq);
+        Bitboard targets = Attacks::king(ksq) & ~own;
+        while (targets) {
+            int to = popLsb(targets);
+            if (!(pos.attackersTo(to, occNoKing) & enemy)) moves.push_back(Move(ksq, to));
+        }
+        // Castling: not out of, through or into check
+        if (!chk) {
+            uint8_t rights = pos.castlingRights();
+            Bitboard rooks = pos.pieces(us, PieceType::ROOK);
+            auto safe = [&](int sq) { return !pos.isSquareAttacked(sq, !us); }; // tracked map when enabled
+            if ((rights & (us ? WHITE_OO : BLACK_OO)) && (rooks & squareBB(ksq + 3))
+                && !(occ & Attacks::between(ksq, ksq + 3)) && safe(ksq + 1) && safe(ksq + 2))
+                moves.push_back(Move(ksq, ksq + 2, MoveKind::CASTLING));
+            if ((rights & (us ? WHITE_OOO : BLACK_OOO)) && (rooks & squareBB(ksq - 4))
+                && !(occ & Attacks::between(ksq, ksq - 4)) && safe(ksq - 1) && safe(ksq - 2))
+                moves.push_back(Move(ksq, ksq - 2, MoveKind::CASTLING));
+        }
+    }
+
+    // Double check: only the king may move
+    if (chk & (chk - 1)) return;
+
+    // Single check: capture the checker or block its ray
+    Bitboard checkMask = chk ? (Attacks::between(ksq, lsbIndex(chk)) | chk) : ~0ULL;
+    Bitboard pinned = pinnedPieces(pos, us);
+    Bitboard movers = own & ~squareBB(ksq) & fromMask;
+
+    // Knights (a pinned knight can never move) and sliders (pinned ones stay on the pin line)
+    Bitboard others = movers & ~pos.pieces(PieceType::PAWN) & ~(pinned & pos.pieces(PieceType::KNIGHT));
+    while (others) {
+        int from = popLsb(others);
+        Bitboard targets = pos.attacksFrom(from, occ) & ~own & checkMask;
+        if (pinned & squareBB(from)) targets &= Attacks::line(ksq, from);
+        while (targets) moves.push_back(Move(from, popLsb(targets)));
+    }
+
+    // Pawns
+    int up = us ? 8 : -8;
+    Bitboard startRank = us ? RANK_2_BB : RANK_7_BB;
+    Bitboard promoRank = us ? RANK_8_BB : RANK_1_BB;
+    Bitboard pawns = movers & pos.pieces(PieceType::PAWN);
+    while (pawns) {
+        int from = popLsb(pawns);
+        Bitboard b = squareBB(from);
+        Bitboard pinMask = (pinned & b) ? Attacks::line(ksq, from) : ~0ULL;
+
+        Bitboard one = shiftBB(b, up) & ~occ;
+        Bitboard targets = one;
+        if (one && (b & startRank)) targets |= shiftBB(one, up) & ~occ;
+        targets |= Attacks::pawn(us, from) & enemy;
+        targets &= checkMask & pinMask;
+        while (targets) {
+            int to = popLsb(targets);
+            if (squareBB(to) & promoRank) addPromotions(moves, from, to);
+            else moves.push_back(Move(from, to));
+        }
+
+        // En-passant: re-test king exposure with both pawns gone (covers the
+        // rank discovered-check case and capturing a checking pawn)
+        int ep = pos.enPassantSquare();
+        if (ep >= 0 && (Attacks::pawn(us, from) & squareBB(ep))) {
+            int victim = ep - up;
+            if (pos.pieces(!us, PieceType::PAWN) & squareBB(victim)) {
+                Bitboard occAfter = (occ ^ b ^ squareBB(victim)) | squareBB(ep);
+                Bitboard queens = pos.pieces(PieceType::QUEEN);
+                Bitboard sliders = ((Attacks::rook(ksq, occAfter) & (pos.pieces(PieceType::ROOK) | queens))
+                                  | (Attacks::bishop(ksq, occAfter) & (pos.pieces(PieceType::BISHOP) | queens))) & enemy;
+                Bitboard leapers = chk & ~squareBB(victim) & (pos.pieces(PieceType::KNIGHT) | pos.pieces(PieceType::PAWN));
+                if (!sliders && !leapers) moves.push_back(Move(from, ep, MoveKind::EN_PASSANT));
+            }
+        }
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "MoveList.h"
+#include "Position.h"
+
+// Fully-legal move generation: checkers and pins are found once per position,
+// so no candidate move has to be simulated to test king safety
+class MoveGen {
+public:
+    // All legal moves for the side to move
+    static void generateLegal(const Position& pos, MoveList& moves);
+
+    // Legal moves of the side-to-move piece standing on 'from'
+    static void generateLegalFrom(const Position& pos, int from, MoveList& moves);
+
+    // Checkers of the side to move and its absolutely pinned pieces
+    static Bitboard checkers(const Position& pos);
+    static Bitboard pinnedPieces(const Position& pos, bool isWhite);
+
+private:
+    static void generate(const Position& pos, Bitboard fromMask, MoveList& moves);
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Move.h"
+
+// Fixed-capacity move buffer that lives on the stack; generators append to a
+// caller-provided list, so steady-state move generation never touches the heap.
+// 256 entries cover the maximum of 218 legal moves in any chess position.
+class MoveList {
+public:
+    static const int CAPACITY = 256;
+
+    MoveList() : count(0) {}
+
+    void push_back(Move m) { moves[count++] = m; }
+    void clear() { count = 0; }
+    // Drop the entry at i by moving the last one into its place (order not kept)
+    void removeAt(int i) { moves[i] = moves[--count]; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool contains(Move m) const {
+        for (int i = 0; i < count; ++i) if (moves[i] == m) return true;
+        return false;
+    }
+
+    Move& operator[](int i) { return moves[i]; }
+    const Move& operator[](int i) const { return moves[i]; }
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+private:
+    Move moves[CAPACITY];
+    int count;
+};
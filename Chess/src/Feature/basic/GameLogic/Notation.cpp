@@ -0,0 +1,283 @@
+#include "Notation.h"
+#include "MoveGen.h"
+#include <cstdlib>
+#include <sstream>
+
+const char* Notation::START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static bool pieceFromChar(char c, PieceType& type, bool& isWhite) {
+    isWhite = (c >= 'A' && c <= 'Z');
+    switch (isWhite ? (char)(c - 'A' + 'a') : c) {
+        case 'p': type = PieceType::PAWN;   return true;
+        case 'n': type = PieceType::KNIGHT; return true;
+        case 'b': type = PieceType::BISHOP; return true;
+        case 'r': type = PieceType::ROOK;   return true;
+        case 'q': type = PieceType::QUEEN;  return true;
+        case 'k': type = PieceType::KING;   return true;
+        default:  return false;
+    }
+}
+
+// Non-negative decimal move counter; false on anything else
+static bool parseCounter(const std::string& s, int& value) {
+    if (s.empty() || s.size() > 9 || s.find_first_not_of("0123456789") != std::string::npos) return false;
+    value = std::atoi(s.c_str());
+    return true;
+}
+
+bool Notation::setFromFEN(Position& pos, const std::string& fen) {
+    pos.clear();
+    std::istringstream in(fen);
+    std::string placement, side, castling, ep, halfmoveField, fullmoveField, extra;
+    int halfmove = 0, fullmove = 1;
+    if (!(in >> placement >> side)) return false;
+    if (!(in >> castling)) castling = "-";
+    if (!(in >> ep)) ep = "-";
+    // Counters are optional (a lone halfmove clock is kept); anything after them is an error
+    if (in >> halfmoveField && !parseCounter(halfmoveField, halfmove)) return false;
+    if (in >> fullmoveField && !parseCounter(fullmoveField, fullmove)) return false;
+    if (in >> extra) return false;
+
+    int file = 0, rank = 7, index = 0;
+    for (char c : placement) {
+        if (c == '/') { if (file != 8) { pos.clear(); return false; } file = 0; --rank; continue; }
+        if (c >= '1' && c <= '8') { file += c - '0'; if (file > 8) { pos.clear(); return false; } continue; }
+        PieceType type; bool isWhite;
+        if (!pieceFromChar(c, type, isWhite) || file > 7 || rank < 0 || index > 127) { pos.clear(); return false; }
+        pos.addPiece(squareOf(file, rank), type, isWhite, index++);
+        ++file;
+    }
+    if (rank != 0 || file != 8) { pos.clear(); return false; }
+
+    if (side != "w" && side != "b") { pos.clear(); return false; }
+    pos.setWhiteToMove(side == "w");
+
+    uint8_t rights = 0;
+    if (castling != "-") {
+        for (char c : castling) {
+            switch (c) {
+                case 'K': rights |= WHITE_OO; break;
+                case 'Q': rights |= WHITE_OOO; break;
+                case 'k': rights |= BLACK_OO; break;
+                case 'q': rights |= BLACK_OOO; break;
+                default: pos.clear(); return false;
+            }
+        }
+    }
+    pos.setCastlingRights(rights);
+
+    if (ep != "-") {
+        int sq = stringToSquare(ep);
+        if (sq < 0) { pos.clear(); return false; }
+        pos.setEnPassantSquare(sq);
+    }
+    pos.setHalfmoveClock(halfmove < 0 ? 0 : halfmove);
+    pos.setFullmoveNumber(fullmove < 1 ? 1 : fullmove);
+    return true;
+}
+
+// Placement, side, castling and en-passant fields shared by FEN and EPD
+static std::string positionFields(const Position& pos) {
+    static const char LETTERS[] = "prnbqk"; // PieceType order
+    std::string s;
+    for (int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            int sq = squareOf(file, rank);
+            if (pos.isEmpty(sq)) { ++empty; continue; }
+            if (empty) { s += (char)('0' + empty); empty = 0; }
+            char c = LETTERS[(int)pos.typeAt(sq)];
+            s += pos.isWhiteAt(sq) ? (char)(c - 'a' + 'A') : c;
+        }
+        if (empty) s += (char)('0' + empty);
+        if (rank) s += '/';
+    }
+    s += pos.whiteToMove() ? " w " : " b ";
+    uint8_t rights = pos.castlingRights();
+    if (rights & WHITE_OO) s += 'K';
+    if (rights & WHITE_OOO) s += 'Q';
+    if (rights & BLACK_OO) s += 'k';
+    if (rights & BLACK_OOO) s += 'q';
+    if (!rights) s += '-';
+    s += ' ';
+    s += pos.enPassantSquare() >= 0 ? Notation::squareToString(pos.enPassantSquare()) : "-";
+    return s;
+}
+
+std::string Notation::toFEN(const Position& pos) {
+    return positionFields(pos) + " " + std::to_string(pos.halfmoveClock()) + " " + std::to_string(pos.fullmoveNumber());
+}
+
+static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+bool Notation::setFromEPD(Position& pos, const std::string& epd, EpdOps* ops) {
+    // Four position fields, then operations
+    size_t i = 0, n = epd.size();
+    for (int field = 0; field < 4; ++field) {
+        while (i < n && isSpace(epd[i])) ++i;
+        if (i == n) { pos.clear(); return false; }
+        while (i < n && !isSpace(epd[i])) ++i;
+    }
+    if (!setFromFEN(pos, epd.substr(0, i) + " 0 1")) return false;
+    if (ops) ops->clear();
+
+    while (i < n) {
+        while (i < n && (isSpace(epd[i]) || epd[i] == ';')) ++i;
+        if (i == n) break;
+        size_t start = i;
+        while (i < n && !isSpace(epd[i]) && epd[i] != ';') ++i;
+        std::string opcode = epd.substr(start, i - start);
+        // Operands run to the next semicolon outside a quoted string
+        while (i < n && isSpace(epd[i])) ++i;
+        start = i;
+        bool quoted = false;
+        while (i < n && (quoted || epd[i] != ';')) { if (epd[i] == '"') quoted = !quoted; ++i; }
+        if (quoted || i == n) { pos.clear(); return false; } // every operation ends with ';'
+        size_t end = i;
+        while (end > start && isSpace(epd[end - 1])) --end;
+        std::string operand = epd.substr(start, end - start);
+        ++i;
+
+        if (opcode == "hmvc" || opcode == "fmvn") {
+            int value = std::atoi(operand.c_str());
+            if (opcode == "hmvc") pos.setHalfmoveClock(value < 0 ? 0 : value);
+            else pos.setFullmoveNumber(value < 1 ? 1 : value);
+        }
+        if (ops) ops->emplace_back(opcode, operand);
+    }
+    return true;
+}
+
+std::string Notation::toEPD(const Position& pos, const EpdOps& ops) {
+    std::string s = positionFields(pos);
+    for (const auto& op : ops) {
+        s += ' ';
+        s += op.first;
+        if (!op.second.empty()) { s += ' '; s += op.second; }
+        s += ';';
+    }
+    return s;
+}
+
+static const char SAN_LETTERS[] = "PRNBQK"; // PieceType order
+
+static bool sanPiece(char c, PieceType& type) {
+    for (int t = 1; t < 6; ++t) if (SAN_LETTERS[t] == c) { type = (PieceType)t; return true; }
+    return false;
+}
+
+Move Notation::moveFromSAN(const Position& pos, const std::string& sanIn) {
+    // Drop check marks and annotation glyphs, then capture/separator characters
+    size_t n = sanIn.size();
+    while (n > 0 && (sanIn[n - 1] == '+' || sanIn[n - 1] == '#' || sanIn[n - 1] == '!' || sanIn[n - 1] == '?')) --n;
+    std::string san;
+    for (size_t i = 0; i < n; ++i) if (sanIn[i] != 'x' && sanIn[i] != ':') san += sanIn[i];
+
+    MoveList moves;
+    MoveGen::generateLegal(pos, moves);
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        bool kingSide = san.size() == 3;
+        for (const Move& m : moves)
+            if (m.kind() == MoveKind::CASTLING && (m.to() > m.from()) == kingSide) return m;
+        return Move();
+    }
+
+    PieceType type = PieceType::PAWN, promotion = PieceType::PAWN;
+    size_t i = 0;
+    if (!san.empty() && sanPiece(san[0], type)) i = 1;
+    size_t end = san.size();
+    if (end > i && san[end - 1] != '=' && (sanPiece(san[end - 1], promotion) ||
+        (san[end - 1] >= 'a' && sanPiece((char)(san[end - 1] - 'a' + 'A'), promotion)))) { // also "e8q"
+        if (promotion == PieceType::KING) return Move();
+        --end;
+        if (end > i && san[end - 1] == '=') --end;
+    }
+    std::string body;
+    for (size_t k = i; k < end; ++k) if (san[k] != '-') body += san[k];
+    if (body.size() < 2 || body.size() > 4) return Move();
+    int to = stringToSquare(body.substr(body.size() - 2));
+    if (to < 0) return Move();
+    // Optional disambiguation: origin file, rank or both
+    int fromFile = -1, fromRank = -1;
+    for (size_t k = 0; k + 2 < body.size(); ++k) {
+        if (body[k] >= 'a' && body[k] <= 'h') fromFile = body[k] - 'a';
+        else if (body[k] >= '1' && body[k] <= '8') fromRank = body[k] - '1';
+        else return Move();
+    }
+
+    Move found;
+    for (const Move& m : moves) {
+        if (m.to() != to || pos.typeAt(m.from()) != type) continue;
+        if ((fromFile >= 0 && fileOf(m.from()) != fromFile) || (fromRank >= 0 && rankOf(m.from()) != fromRank)) continue;
+        bool isPromotion = m.kind() == MoveKind::PROMOTION;
+        if (isPromotion != (promotion != PieceType::PAWN) || (isPromotion && m.promotion() != promotion)) continue;
+        if (!found.isNone()) return Move(); // ambiguous
+        found = m;
+    }
+    return found;
+}
+
+std::string Notation::moveToSAN(const Position& pos, Move m) {
+    std::string s;
+    int from = m.from(), to = m.to();
+    PieceType type = pos.typeAt(from);
+    if (m.kind() == MoveKind::CASTLING) {
+        s = to > from ? "O-O" : "O-O-O";
+    } else {
+        bool capture = !pos.isEmpty(to) || m.kind() == MoveKind::EN_PASSANT;
+        if (type == PieceType::PAWN) {
+            if (capture) s += (char)('a' + fileOf(from));
+        } else {
+            s += SAN_LETTERS[(int)type];
+            // Name the origin file, else rank, else both when another piece of the same kind can go there
+            MoveList moves;
+            MoveGen::generateLegal(pos, moves);
+            bool clash = false, sameFile = false, sameRank = false;
+            for (const Move& o : moves) {
+                if (o.to() != to || o.from() == from || pos.typeAt(o.from()) != type) continue;
+                clash = true;
+                sameFile |= fileOf(o.from()) == fileOf(from);
+                sameRank |= rankOf(o.from()) == rankOf(from);
+            }
+            if (clash && (!sameFile || sameRank)) s += (char)('a' + fileOf(from));
+            if (clash && sameFile) s += (char)('1' + rankOf(from));
+        }
+        if (capture) s += 'x';
+        s += squareToString(to);
+        if (m.kind() == MoveKind::PROMOTION) { s += '='; s += SAN_LETTERS[(int)m.promotion()]; }
+    }
+    Position after = pos;
+    after.makeMove(m);
+    if (after.inCheck(after.whiteToMove())) {
+        MoveList replies;
+        MoveGen::generateLegal(after, replies);
+        s += replies.empty() ? '#' : '+';
+    }
+    return s;
+}
+
+std::string Notation::squareToString(int sq) {
+    std::string s;
+    s += (char)('a' + fileOf(sq));
+    s += (char)('1' + rankOf(sq));
+    return s;
+}
+
+int Notation::stringToSquare(const std::string& s) {
+    if (s.size() < 2 || s[0] < 'a' || s[0] > 'h' || s[1] < '1' || s[1] > '8') return -1;
+    return squareOf(s[0] - 'a', s[1] - '1');
+}
+
+std::string Notation::moveToString(Move m) {
+    if (m.isNone()) return "0000";
+    std::string s = squareToString(m.from()) + squareToString(m.to());
+    if (m.kind() == MoveKind::PROMOTION) {
+        switch (m.promotion()) {
+            case PieceType::QUEEN:  s += 'q'; break;
+            case PieceType::ROOK:   s += 'r'; break;
+            case PieceType::BISHOP: s += 'b'; break;
+            default:                s += 'n'; break;
+        }
+    }
+    return s;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Position.h"
+
+// EPD operations in file order: opcode and its operand text as written (quotes kept, "" if none)
+typedef std::vector<std::pair<std::string, std::string>> EpdOps;
+
+// Text notation for positions and moves (FEN, EPD, coordinate move strings)
+class Notation {
+public:
+    static const char* START_FEN;
+
+    // Load a FEN string; returns false (and leaves pos cleared) on malformed input, including
+    // non-numeric move counters or tokens after them. Missing trailing fields take their defaults
+    static bool setFromFEN(Position& pos, const std::string& fen);
+    // Full six-field FEN of pos
+    static std::string toFEN(const Position& pos);
+
+    // EPD: the first four FEN fields followed by "opcode operands;" operations. The hmvc and
+    // fmvn opcodes set the move counters; every operation is returned in 'ops' when given
+    static bool setFromEPD(Position& pos, const std::string& epd, EpdOps* ops = nullptr);
+    static std::string toEPD(const Position& pos, const EpdOps& ops = EpdOps());
+
+    // Standard algebraic notation, resolved through the legal move generator. moveFromSAN
+    // accepts check/annotation suffixes, "0-0" castling, long forms ("Ng1-f3") and
+    // promotions with or without '='; it returns no move for illegal or ambiguous text
+    static Move moveFromSAN(const Position& pos, const std::string& san);
+    static std::string moveToSAN(const Position& pos, Move m); // m must be legal in pos
+
+    // Square / move text ("e4", "e7e8q")
+    static std::string squareToString(int sq);
+    static int stringToSquare(const std::string& s);
+    static std::string moveToString(Move m);
+};
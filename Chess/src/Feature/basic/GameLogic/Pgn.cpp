@@ -0,0 +1,149 @@
+#include "Pgn.h"
+#include "Notation.h"
+#include <cstring>
+
+std::string PgnGame::tag(const std::string& name) const {
+    for (const auto& t : tags) if (t.first == name) return t.second;
+    return "";
+}
+
+static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Index just past the end of the line containing i (len if the line is unterminated)
+static size_t lineEnd(const char* text, size_t len, size_t i) {
+    const char* nl = (const char*)std::memchr(text + i, '\n', len - i);
+    return nl ? (size_t)(nl - text) + 1 : len;
+}
+
+bool Pgn::nextGame(const char* text, size_t len, bool atEnd, size_t& begin, size_t& end) {
+    size_t i = 0;
+    while (i < len && isBlank(text[i])) ++i;
+    begin = end = i;
+    if (i == len) return false;
+    bool inMoves = false, lineStart = true;
+    while (i < len) {
+        char c = text[i];
+        if (lineStart) {
+            lineStart = false;
+            if (c == '[') {
+                if (inMoves) { end = i; return true; } // tags of the next game
+                i = lineEnd(text, len, i);            // tag values may hold any character
+                lineStart = true;
+                continue;
+            }
+            if (c == '%') { i = lineEnd(text, len, i); lineStart = true; continue; } // escape line
+        }
+        if (c == '\n') { lineStart = true; ++i; continue; }
+        if (c == '{') {
+            const char* close = (const char*)std::memchr(text + i, '}', len - i);
+            if (!close) break;
+            i = (size_t)(close - text) + 1;
+            inMoves = true;
+            continue;
+        }
+        if (c == ';') { i = lineEnd(text, len, i); lineStart = true; inMoves = true; continue; }
+        if (!isBlank(c)) inMoves = true;
+        ++i;
+    }
+    end = len;
+    return atEnd;
+}
+
+static bool isResult(const char* s, size_t n) {
+    return (n == 1 && s[0] == '*') || (n == 3 && (std::memcmp(s, "1-0", 3) == 0 || std::memcmp(s, "0-1", 3) == 0))
+        || (n == 7 && std::memcmp(s, "1/2-1/2", 7) == 0);
+}
+
+bool Pgn::replay(const char* text, size_t len, Position& pos, PgnGame& game, std::vector<Move>* moves) {
+    game = PgnGame();
+    if (moves) moves->clear();
+    auto fail = [&](const char* why) { game.ok = false; game.error = why; return false; };
+    size_t i = 0;
+
+    // Tag pairs: [Name "value"] with \" and \\ escapes
+    for (;;) {
+        while (i < len && isBlank(text[i])) ++i;
+        if (i < len && (text[i] == '%' || text[i] == ';')) { i = lineEnd(text, len, i); continue; }
+        if (i == len || text[i] != '[') break;
+        ++i;
+        while (i < len && isBlank(text[i])) ++i;
+        size_t nameStart = i;
+        while (i < len && !isBlank(text[i]) && text[i] != '"' && text[i] != ']') ++i;
+        std::string name(text + nameStart, i - nameStart);
+        while (i < len && isBlank(text[i])) ++i;
+        if (name.empty() || i == len || text[i] != '"') return fail("malformed tag pair");
+        std::string value;
+        for (++i; i < len && text[i] != '"'; ++i) {
+            if (text[i] == '\\' && i + 1 < len) ++i;
+            value += text[i];
+        }
+        const char* close = i < len ? (const char*)std::memchr(text + i, ']', len - i) : nullptr;
+        if (!close) return fail("malformed tag pair");
+        i = (size_t)(close - text) + 1;
+        game.tags.emplace_back(std::move(name), std::move(value));
+    }
+
+    std::string variant = game.tag("Variant");
+    if (!variant.empty() && variant != "Standard" && variant != "standard" && variant != "chess")
+        return fail("unsupported variant");
+    std::string fen = game.tag("FEN");
+    if (!Notation::setFromFEN(pos, fen.empty() ? Notation::START_FEN : fen)) return fail("invalid FEN tag");
+
+    // Movetext
+    while (i < len) {
+        char c = text[i];
+        if (isBlank(c)) { ++i; continue; }
+        if (c == '%' && (i == 0 || text[i - 1] == '\n')) { i = lineEnd(text, len, i); continue; }
+        if (c == ';') { i = lineEnd(text, len, i); continue; }
+        if (c == '{') {
+            const char* close = (const char*)std::memchr(text + i, '}', len - i);
+            if (!close) return fail("unterminated comment");
+            i = (size_t)(close - text) + 1;
+            continue;
+        }
+        if (c == '(') {
+            // Recursive annotation variation: skipped, comments inside may hold parentheses
+            int depth = 0;
+            for (; i < len; ++i) {
+                if (text[i] == '(') ++depth;
+                else if (text[i] == ')' && --depth == 0) break;
+                else if (text[i] == '{') {
+                    const char* close = (const char*)std::memchr(text + i, '}', len - i);
+                    if (!close) { i = len; break; }
+                    i = (size_t)(close - text);
+                } else if (text[i] == ';') {
+                    i = lineEnd(text, len, i) - 1;
+                }
+            }
+            if (i >= len) return fail("unterminated variation");
+            ++i;
+            continue;
+        }
+        if (c == '$') { ++i; while (i < len && text[i] >= '0' && text[i] <= '9') ++i; continue; }
+        if (c == ')' || c == '}') return fail("unbalanced variation or comment");
+
+        size_t start = i;
+        while (i < len && !isBlank(text[i]) && !std::strchr("{}();$", text[i])) ++i;
+        const char* tok = text + start;
+        size_t n = i - start;
+        if (isResult(tok, n)) { game.result.assign(tok, n); break; }
+        // Move number ("12." or "12...") possibly glued to the move
+        size_t k = 0;
+        while (k < n && tok[k] >= '0' && tok[k] <= '9') ++k;
+        if (k < n && tok[k] == '-') k = 0; // "0-0" castling
+        while (k < n && tok[k] == '.') ++k;
+        tok += k;
+        n -= k;
+        if (n == 0) continue;
+        std::string san(tok, n);
+        Move m = Notation::moveFromSAN(pos, san);
+        if (m.isNone()) {
+            game.badMove = san;
+            return fail(san == "--" || san == "Z0" ? "null move" : "illegal or ambiguous move");
+        }
+        pos.makeMove(m);
+        if (moves) moves->push_back(m);
+        ++game.plies;
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Position.h"
+
+// Outcome of replaying one PGN game
+struct PgnGame {
+    std::vector<std::pair<std::string, std::string>> tags; // tag pairs in file order
+    std::string result;   // termination marker ("1-0", "0-1", "1/2-1/2", "*"); empty if missing
+    int plies = 0;        // moves replayed before the end or the first error
+    bool ok = true;
+    std::string error;    // why replay stopped early (illegal or ambiguous SAN, bad FEN tag, ...)
+    std::string badMove;  // the SAN token that could not be resolved
+
+    // Value of a tag, "" if absent
+    std::string tag(const std::string& name) const;
+};
+
+// PGN import: splitting a buffer into games and replaying each one through the legal
+// move generator. Works on raw (e.g. memory-mapped) text, nothing is copied per game
+class Pgn {
+public:
+    // Next game in [text, text + len): its first non-blank byte in 'begin' and one past its
+    // end in 'end'. A game ends where the tag section of the following game starts, or at
+    // the end of the buffer when 'atEnd'; otherwise false means it may continue past 'len'
+    // (or only blank text is left, in which case 'begin' == len)
+    static bool nextGame(const char* text, size_t len, bool atEnd, size_t& begin, size_t& end);
+
+    // Replay one game (tags, then movetext with comments, variations and NAGs skipped).
+    // 'pos' ends on the last legal position reached and 'moves' (when given) holds the moves
+    // that led there; returns game.ok
+    static bool replay(const char* text, size_t len, Position& pos, PgnGame& game, std::vector<Move>* moves = nullptr);
+};
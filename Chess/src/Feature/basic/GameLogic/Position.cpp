@@ -0,0 +1,278 @@
+#include "Position.h"
+#include "Attacks.h"
+#include <cstring>
+
+// Castling rights that survive a move touching each square (king/rook home squares)
+static uint8_t castlingMask(int sq) {
+    switch (sq) {
+        case 0:  return ALL_CASTLING & ~WHITE_OOO;
+        case 4:  return ALL_CASTLING & ~(WHITE_OO | WHITE_OOO);
+        case 7:  return ALL_CASTLING & ~WHITE_OO;
+        case 56: return ALL_CASTLING & ~BLACK_OOO;
+        case 60: return ALL_CASTLING & ~(BLACK_OO | BLACK_OOO);
+        case 63: return ALL_CASTLING & ~BLACK_OO;
+        default: return ALL_CASTLING;
+    }
+}
+
+void Position::clear() {
+    Attacks::init(); // positions may be built during static init, before Attacks.cpp runs
+    Zobrist::init();
+    Psqt::init();
+    byColor[0] = byColor[1] = 0;
+    for (int t = 0; t < 6; ++t) byType[t] = 0;
+    occupiedBB = 0;
+    for (int sq = 0; sq < 64; ++sq) { indexOn[sq] = -1; typeOn[sq] = -1; }
+    sideWhite = true;
+    castling = 0;
+    epSquare = -1;
+    halfmove = 0;
+    fullmove = 1;
+    zobrist = 0;
+    psq = 0;
+    phase = 0;
+    undoSize = 0;
+    for (int sq = 0; sq < 64; ++sq) attacksOn[sq] = 0;
+    attackedBB[0] = attackedBB[1] = 0;
+    for (int c = 0; c < 2; ++c) for (int sq = 0; sq < 64; ++sq) attackCount[c][sq] = 0;
+}
+
+void Position::setAttackTracking(bool on) {
+    if (on == trackAttacks) return;
+    trackAttacks = on;
+    for (int sq = 0; sq < 64; ++sq) attacksOn[sq] = 0;
+    attackedBB[0] = attackedBB[1] = 0;
+    for (int c = 0; c < 2; ++c) for (int sq = 0; sq < 64; ++sq) attackCount[c][sq] = 0;
+    if (!on) return;
+    Bitboard occ = occupiedBB;
+    while (occ) addAttacks(popLsb(occ));
+}
+
+void Position::addAttacks(int sq) {
+    int c = isWhiteAt(sq) ? 0 : 1;
+    Bitboard a = attacksFrom(sq, occupiedBB);
+    attacksOn[sq] = a;
+    while (a) {
+        int t = popLsb(a);
+        if (attackCount[c][t]++ == 0) attackedBB[c] |= squareBB(t);
+    }
+}
+
+void Position::removeAttacks(int sq) {
+    int c = isWhiteAt(sq) ? 0 : 1;
+    Bitboard a = attacksOn[sq];
+    attacksOn[sq] = 0;
+    while (a) {
+        int t = popLsb(a);
+        if (--attackCount[c][t] == 0) attackedBB[c] &= ~squareBB(t);
+    }
+}
+
+// Sliders of either color whose ray reaches 'sq'; only their attacks change when the
+// occupancy of 'sq' flips (the squares between slider and target are unaffected)
+Bitboard Position::slidersThrough(int sq) const {
+    Bitboard queens = byType[(int)PieceType::QUEEN];
+    return (Attacks::bishop(sq, occupiedBB) & (byType[(int)PieceType::BISHOP] | queens))
+         | (Attacks::rook(sq, occupiedBB) & (byType[(int)PieceType::ROOK] | queens));
+}
+
+void Position::addPiece(int sq, PieceType type, bool isWhite, int index) {
+    Bitboard sliders = 0;
+    if (trackAttacks) {
+        sliders = slidersThrough(sq);
+        for (Bitboard s = sliders; s; ) removeAttacks(popLsb(s));
+    }
+    Bitboard b = squareBB(sq);
+    byColor[isWhite ? 0 : 1] |= b;
+    byType[(int)type] |= b;
+    occupiedBB |= b;
+    indexOn[sq] = (int8_t)index;
+    typeOn[sq] = (int8_t)type;
+    zobrist ^= Zobrist::piece(isWhite, type, sq);
+    psq += Psqt::value(isWhite, type, sq);
+    phase += (int16_t)Psqt::phase(type);
+    if (trackAttacks) {
+        while (sliders) addAttacks(popLsb(sliders));
+        addAttacks(sq);
+    }
+}
+
+void Position::removePiece(int sq) {
+    if (indexOn[sq] < 0) return;
+    Bitboard sliders = 0;
+    if (trackAttacks) {
+        sliders = slidersThrough(sq);
+        for (Bitboard s = sliders; s; ) removeAttacks(popLsb(s));
+        removeAttacks(sq);
+    }
+    zobrist ^= Zobrist::piece(isWhiteAt(sq), (PieceType)typeOn[sq], sq);
+    psq -= Psqt::value(isWhiteAt(sq), (PieceType)typeOn[sq], sq);
+    phase -= (int16_t)Psqt::phase((PieceType)typeOn[sq]);
+    Bitboard b = ~squareBB(sq);
+    byColor[0] &= b; byColor[1] &= b;
+    byType[typeOn[sq]] &= b;
+    occupiedBB &= b;
+    indexOn[sq] = -1;
+    typeOn[sq] = -1;
+    if (trackAttacks) while (sliders) addAttacks(popLsb(sliders));
+}
+
+void Position::movePiece(int from, int to) {
+    Bitboard sliders = 0;
+    if (trackAttacks) {
+        sliders = (slidersThrough(from) | slidersThrough(to)) & ~squareBB(from);
+        for (Bitboard s = sliders; s; ) removeAttacks(popLsb(s));
+        removeAttacks(from);
+    }
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    bool white = isWhiteAt(from);
+    zobrist ^= Zobrist::piece(white, (PieceType)typeOn[from], from) ^ Zobrist::piece(white, (PieceType)typeOn[from], to);
+    psq += Psqt::value(white, (PieceType)typeOn[from], to) - Psqt::value(white, (PieceType)typeOn[from], from);
+    byColor[white ? 0 : 1] ^= fromTo;
+    byType[typeOn[from]] ^= fromTo;
+    occupiedBB ^= fromTo;
+    indexOn[to] = indexOn[from]; typeOn[to] = typeOn[from];
+    indexOn[from] = -1; typeOn[from] = -1;
+    if (trackAttacks) {
+        while (sliders) addAttacks(popLsb(sliders));
+        addAttacks(to);
+    }
+}
+
+void Position::makeMove(Move m) {
+    if (undoSize == MAX_PLY) {
+        // Long games: forget the oldest half of the history rather than overflow
+        std::memmove(undoStack, undoStack + MAX_PLY / 2, sizeof(UndoState) * (MAX_PLY / 2));
+        undoSize = MAX_PLY / 2;
+    }
+    UndoState& st = undoStack[undoSize++];
+    st.move = m;
+    st.castling = castling;
+    st.epSquare = epSquare;
+    st.halfmove = halfmove;
+    st.key = zobrist;
+    st.capturedType = -1;
+    st.capturedIndex = -1;
+
+    int from = m.from(), to = m.to();
+    bool us = sideWhite;
+
+    // Captured piece (the en-passant victim sits behind the target square)
+    int capSq = (m.kind() == MoveKind::EN_PASSANT) ? to + (us ? -8 : 8) : to;
+    if (m.kind() != MoveKind::CASTLING && !isEmpty(capSq)) {
+        st.capturedType = typeOn[capSq];
+        st.capturedIndex = indexOn[capSq];
+        removePiece(capSq);
+    }
+
+    halfmove = (st.capturedType >= 0 || typeOn[from] == (int8_t)PieceType::PAWN) ? 0 : halfmove + 1;
+    if (!us) ++fullmove;
+
+    movePiece(from, to);
+    if (m.kind() == MoveKind::CASTLING) {
+        bool kingSide = to > from;
+        movePiece(kingSide ? to + 1 : to - 2, kingSide ? to - 1 : to + 1);
+    } else if (m.kind() == MoveKind::PROMOTION) {
+        int idx = indexOn[to];
+        removePiece(to);
+        addPiece(to, m.promotion(), us, idx);
+    }
+
+    setCastlingRights(castling & castlingMask(from) & castlingMask(to));
+    setEnPassantSquare(typeOn[to] == (int8_t)PieceType::PAWN && (to - from == 16 || from - to == 16) ? (from + to) / 2 : -1);
+    sideWhite = !sideWhite;
+    zobrist ^= Zobrist::side();
+}
+
+void Position::unmakeMove() {
+    const UndoState& st = undoStack[--undoSize];
+    Move m = st.move;
+    int from = m.from(), to = m.to();
+    sideWhite = !sideWhite;
+    bool us = sideWhite;
+
+    if (m.kind() == MoveKind::PROMOTION) {
+        int idx = indexOn[to];
+        removePiece(to);
+        addPiece(to, PieceType::PAWN, us, idx);
+    } else if (m.kind() == MoveKind::CASTLING) {
+        bool kingSide = to > from;
+        movePiece(kingSide ? to - 1 : to + 1, kingSide ? to + 1 : to - 2);
+    }
+    movePiece(to, from);
+
+    if (st.capturedType >= 0) {
+        int capSq = (m.kind() == MoveKind::EN_PASSANT) ? to + (us ? -8 : 8) : to;
+        addPiece(capSq, (PieceType)st.capturedType, !us, st.capturedIndex);
+    }
+    castling = st.castling;
+    epSquare = st.epSquare;
+    halfmove = st.halfmove;
+    if (!us) --fullmove;
+    zobrist = st.key; // the piece updates above re-toggled it; restore the saved key exactly
+}
+
+bool Position::isRepetition() const {
+    // Same side to move only; positions before an irreversible move can never match
+    int oldest = undoSize - halfmove;
+    for (int i = undoSize - 2; i >= 0 && i >= oldest; i -= 2)
+        if (undoStack[i].key == zobrist) return true;
+    return false;
+}
+
+uint64_t Position::computeKey() const {
+    uint64_t k = Zobrist::castling(castling) ^ Zobrist::enPassant(epSquare);
+    if (!sideWhite) k ^= Zobrist::side();
+    Bitboard occ = occupiedBB;
+    while (occ) {
+        int sq = popLsb(occ);
+        k ^= Zobrist::piece(isWhiteAt(sq), (PieceType)typeOn[sq], sq);
+    }
+    return k;
+}
+
+Score Position::computePsqScore() const {
+    Score s = 0;
+    for (Bitboard occ = occupiedBB; occ; ) {
+        int sq = popLsb(occ);
+        s += Psqt::value(isWhiteAt(sq), (PieceType)typeOn[sq], sq);
+    }
+    return s;
+}
+
+int Position::kingSquare(bool isWhite) const {
+    Bitboard k = pieces(isWhite, PieceType::KING);
+    return k ? lsbIndex(k) : -1;
+}
+
+Bitboard Position::attacksFrom(int sq, Bitboard occ) const {
+    switch ((PieceType)typeOn[sq]) {
+        case PieceType::PAWN:   return Attacks::pawn(isWhiteAt(sq), sq);
+        case PieceType::KNIGHT: return Attacks::knight(sq);
+        case PieceType::BISHOP: return Attacks::bishop(sq, occ);
+        case PieceType::ROOK:   return Attacks::rook(sq, occ);
+        case PieceType::QUEEN:  return Attacks::queen(sq, occ);
+        case PieceType::KING:   return Attacks::king(sq);
+    }
+    return 0;
+}
+
+Bitboard Position::attackersTo(int sq, Bitboard occ) const {
+    Bitboard queens = byType[(int)PieceType::QUEEN];
+    return (Attacks::pawn(false, sq) & pieces(true, PieceType::PAWN))
+         | (Attacks::pawn(true, sq) & pieces(false, PieceType::PAWN))
+         | (Attacks::knight(sq) & byType[(int)PieceType::KNIGHT])
+         | (Attacks::king(sq) & byType[(int)PieceType::KING])
+         | (Attacks::bishop(sq, occ) & (byType[(int)PieceType::BISHOP] | queens))
+         | (Attacks::rook(sq, occ) & (byType[(int)PieceType::ROOK] | queens));
+}
+
+bool Position::isSquareAttacked(int sq, bool byWhite) const {
+    if (trackAttacks) return (attackedBB[byWhite ? 0 : 1] & squareBB(sq)) != 0;
+    return (attackersTo(sq, occupiedBB) & pieces(byWhite)) != 0;
+}
+
+bool Position::inCheck(bool isWhite) const {
+    int k = kingSquare(isWhite);
+    return k >= 0 && isSquareAttacked(k, !isWhite);
+}
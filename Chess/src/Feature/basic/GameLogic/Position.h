@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include "Bitboard.h"
+#include "Move.h"
+#include "CoreTypes.h"
+#include "Psqt.h"
+#include "Zobrist.h"
+
+// Castling right bits
+enum CastlingRight : uint8_t {
+    WHITE_OO = 1, WHITE_OOO = 2, BLACK_OO = 4, BLACK_OOO = 8,
+    ALL_CASTLING = 15
+};
+
+// State saved by makeMove so unmakeMove can restore the position exactly
+struct UndoState {
+    Move move;
+    int8_t capturedType;    // PieceType of the captured piece, -1 if none
+    int8_t capturedIndex;   // caller's piece index of the captured piece
+    uint8_t castling;       // castling rights before the move (king/rook hasMoved)
+    int8_t epSquare;        // en-passant target before the move, -1 if none
+    int16_t halfmove;       // halfmove clock before the move
+    uint64_t key;           // Zobrist key before the move
+};
+
+// Bitboard position: per-color, per-type and occupancy sets plus a square mailbox.
+// A plain value type holding the whole rules state (placement, side to move, castling,
+// en passant, move counters), so copies can be searched or played on any thread.
+class Position {
+public:
+    static const int MAX_PLY = 128;
+
+    Position() : trackAttacks(false) { clear(); }
+
+    // Remove every piece and reset side to move, castling and en-passant state
+    // (attack tracking stays as configured)
+    void clear();
+
+    // Optional per-side attack maps kept up to date by every mutator. Off by default:
+    // the search and perft never query them; the game's Position turns them on once
+    // (BoardSync) and its check and castling queries read them across every move.
+    void setAttackTracking(bool on);
+    bool attackTracking() const { return trackAttacks; }
+
+    // Place / remove pieces; 'index' links the square back to the caller's piece list
+    void addPiece(int sq, PieceType type, bool isWhite, int index);
+    void removePiece(int sq);
+    void movePiece(int from, int to);
+
+    // Game state
+    bool whiteToMove() const { return sideWhite; }
+    void setWhiteToMove(bool white) { if (white != sideWhite) zobrist ^= Zobrist::side(); sideWhite = white; }
+    uint8_t castlingRights() const { return castling; }
+    void setCastlingRights(uint8_t rights) { zobrist ^= Zobrist::castling(castling) ^ Zobrist::castling(rights); castling = rights; }
+    int enPassantSquare() const { return epSquare; }
+    void setEnPassantSquare(int sq) { zobrist ^= Zobrist::enPassant(epSquare) ^ Zobrist::enPassant(sq); epSquare = (int8_t)sq; }
+    // Plies since the last capture or pawn move, and the move number (starts at 1, bumped after Black moves)
+    int halfmoveClock() const { return halfmove; }
+    void setHalfmoveClock(int n) { halfmove = (int16_t)n; }
+    int fullmoveNumber() const { return fullmove; }
+    void setFullmoveNumber(int n) { fullmove = (int16_t)n; }
+
+    // Zobrist key of placement, side to move, castling rights and en-passant file
+    // (kept up to date by every mutator; computeKey() rebuilds it from scratch)
+    uint64_t key() const { return zobrist; }
+    uint64_t computeKey() const;
+    // Material plus piece-square score (White minus Black) and game phase of the pieces on
+    // the board, kept up to date by every mutator like the key (computePsqScore() rebuilds it)
+    Score psqScore() const { return psq; }
+    Score computePsqScore() const;
+    int gamePhase() const { return phase; }
+
+    // Reversible move application (no allocation; history lives on a fixed undo stack).
+    // A full stack drops its oldest half, so only the latest MAX_PLY/2 moves are always undoable.
+    void makeMove(Move m);
+    void unmakeMove();
+    int historySize() const { return undoSize; }
+    // True if the current position already occurred since the undo stack was started
+    bool isRepetition() const;
+
+    // Set queries
+    Bitboard occupied() const { return occupiedBB; }
+    Bitboard pieces(bool isWhite) const { return byColor[isWhite ? 0 : 1]; }
+    Bitboard pieces(PieceType type) const { return byType[(int)type]; }
+    Bitboard pieces(bool isWhite, PieceType type) const { return byColor[isWhite ? 0 : 1] & byType[(int)type]; }
+
+    // Mailbox queries (empty squares return -1)
+    bool isEmpty(int sq) const { return indexOn[sq] < 0; }
+    int pieceIndexAt(int sq) const { return indexOn[sq]; }
+    PieceType typeAt(int sq) const { return (PieceType)typeOn[sq]; }
+    bool isWhiteAt(int sq) const { return (byColor[0] & squareBB(sq)) != 0; }
+    int kingSquare(bool isWhite) const;
+
+    // Attack queries
+    Bitboard attacksFrom(int sq, Bitboard occ) const;
+    Bitboard attackersTo(int sq, Bitboard occ) const;
+    bool isSquareAttacked(int sq, bool byWhite) const;
+    bool inCheck(bool isWhite) const;
+
+    // Tracked attack maps (valid only while attackTracking() is on)
+    Bitboard attackedBy(bool byWhite) const { return attackedBB[byWhite ? 0 : 1]; }
+    int attackerCount(int sq, bool byWhite) const { return attackCount[byWhite ? 0 : 1][sq]; }
+
+private:
+    // Attack-map bookkeeping for one piece, and for the sliders whose rays cross 'sq'
+    void addAttacks(int sq);
+    void removeAttacks(int sq);
+    Bitboard slidersThrough(int sq) const;
+
+    Bitboard byColor[2];   // [0] white, [1] black
+    Bitboard byType[6];    // indexed by PieceType
+    Bitboard occupiedBB;
+    int8_t indexOn[64];    // caller's piece index on each square
+    int8_t typeOn[64];     // PieceType on each square
+
+    bool sideWhite;
+    uint8_t castling;
+    int8_t epSquare;
+    int16_t halfmove;
+    int16_t fullmove;
+    uint64_t zobrist;
+    Score psq;
+    int16_t phase;
+
+    bool trackAttacks;
+    Bitboard attacksOn[64];       // squares attacked by the piece on each square
+    Bitboard attackedBB[2];       // union of attacks per side
+    uint8_t attackCount[2][64];   // number of pieces of each side attacking each square
+
+    UndoState undoStack[MAX_PLY];
+    int undoSize;
+};
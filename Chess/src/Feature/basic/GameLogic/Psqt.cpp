@@ -0,0 +1,112 @@
+#include "Psqt.h"
+
+Score Psqt::table[2][6][64];
+const int Psqt::PHASE_WEIGHT[6] = { 0, 2, 1, 1, 4, 0 }; // by PieceType
+
+static struct PsqtStartup { PsqtStartup() { Psqt::init(); } } psqtStartup;
+
+// Material by PieceType, centipawns: pawns and rooks gain in the endgame, knights lose
+static const int VALUE_MG[6] = { 100, 500, 320, 330, 900, 0 };
+static const int VALUE_EG[6] = { 120, 530, 290, 320, 940, 0 };
+
+// Tables are written from White's side with rank 8 on the first row
+static const int PAWN_MG_PST[64] = {
+      0,  0,  0,  0,  0,  0,  0,  0,
+     50, 50, 50, 50, 50, 50, 50, 50,
+     10, 10, 20, 30, 30, 20, 10, 10,
+      5,  5, 10, 25, 25, 10,  5,  5,
+      0,  0,  0, 20, 20,  0,  0,  0,
+      5, -5,-10,  0,  0,-10, -5,  5,
+      5, 10, 10,-20,-20, 10, 10,  5,
+      0,  0,  0,  0,  0,  0,  0,  0
+};
+static const int PAWN_EG_PST[64] = {
+      0,  0,  0,  0,  0,  0,  0,  0,
+     80, 80, 80, 80, 80, 80, 80, 80,
+     50, 50, 50, 50, 50, 50, 50, 50,
+     30, 30, 30, 30, 30, 30, 30, 30,
+     15, 15, 15, 15, 15, 15, 15, 15,
+      5,  5,  5,  5,  5,  5,  5,  5,
+      0,  0,  0,  0,  0,  0,  0,  0,
+      0,  0,  0,  0,  0,  0,  0,  0
+};
+static const int KNIGHT_PST[64] = {
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    -40,-20,  0,  0,  0,  0,-20,-40,
+    -30,  0, 10, 15, 15, 10,  0,-30,
+    -30,  5, 15, 20, 20, 15,  5,-30,
+    -30,  0, 15, 20, 20, 15,  0,-30,
+    -30,  5, 10, 15, 15, 10,  5,-30,
+    -40,-20,  0,  5,  5,  0,-20,-40,
+    -50,-40,-30,-30,-30,-30,-40,-50
+};
+static const int BISHOP_PST[64] = {
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5, 10, 10,  5,  0,-10,
+    -10,  5,  5, 10, 10,  5,  5,-10,
+    -10,  0, 10, 10, 10, 10,  0,-10,
+    -10, 10, 10, 10, 10, 10, 10,-10,
+    -10,  5,  0,  0,  0,  0,  5,-10,
+    -20,-10,-10,-10,-10,-10,-10,-20
+};
+static const int ROOK_PST[64] = {
+      0,  0,  0,  0,  0,  0,  0,  0,
+      5, 10, 10, 10, 10, 10, 10,  5,
+     -5,  0,  0,  0,  0,  0,  0, -5,
+     -5,  0,  0,  0,  0,  0,  0, -5,
+     -5,  0,  0,  0,  0,  0,  0, -5,
+     -5,  0,  0,  0,  0,  0,  0, -5,
+     -5,  0,  0,  0,  0,  0,  0, -5,
+      0,  0,  0,  5,  5,  0,  0,  0
+};
+static const int QUEEN_PST[64] = {
+    -20,-10,-10, -5, -5,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5,  5,  5,  5,  0,-10,
+     -5,  0,  5,  5,  5,  5,  0, -5,
+      0,  0,  5,  5,  5,  5,  0, -5,
+    -10,  5,  5,  5,  5,  5,  0,-10,
+    -10,  0,  5,  0,  0,  0,  0,-10,
+    -20,-10,-10, -5, -5,-10,-10,-20
+};
+static const int KING_MG_PST[64] = {
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -20,-30,-30,-40,-40,-30,-30,-20,
+    -10,-20,-20,-20,-20,-20,-20,-10,
+     20, 20,  0,  0,  0,  0, 20, 20,
+     20, 30, 10,  0,  0, 10, 30, 20
+};
+static const int KING_EG_PST[64] = {
+    -50,-40,-30,-20,-20,-30,-40,-50,
+    -30,-20,-10,  0,  0,-10,-20,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-30,  0,  0,  0,  0,-30,-30,
+    -50,-30,-30,-30,-30,-30,-30,-50
+};
+
+void Psqt::init() {
+    static const bool ready = build();
+    (void)ready;
+}
+
+bool Psqt::build() {
+    // Pieces other than pawns and the king use one table for both phases
+    static const int* const MG[6] = { PAWN_MG_PST, ROOK_PST, KNIGHT_PST, BISHOP_PST, QUEEN_PST, KING_MG_PST };
+    static const int* const EG[6] = { PAWN_EG_PST, ROOK_PST, KNIGHT_PST, BISHOP_PST, QUEEN_PST, KING_EG_PST };
+    for (int t = 0; t < 6; ++t) {
+        for (int sq = 0; sq < 64; ++sq) {
+            // Mirror the square for White so both colors read the table from their own side
+            int idx = (7 - (sq >> 3)) * 8 + (sq & 7);
+            table[0][t][sq] = makeScore(VALUE_MG[t] + MG[t][idx], VALUE_EG[t] + EG[t][idx]);
+            table[1][t][sq] = -makeScore(VALUE_MG[t] + MG[t][sq], VALUE_EG[t] + EG[t][sq]);
+        }
+    }
+    return true;
+}
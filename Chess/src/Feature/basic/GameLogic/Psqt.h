@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include "CoreTypes.h"
+
+// Middlegame and endgame values packed into one integer so both are summed with a
+// single add: the endgame half in the low 16 bits, the middlegame half above it
+typedef int32_t Score;
+
+constexpr Score makeScore(int mg, int eg) { return (Score)((uint32_t)mg << 16) + eg; }
+inline int mgScore(Score s) { return (int16_t)(uint16_t)((uint32_t)(s + 0x8000) >> 16); }
+inline int egScore(Score s) { return (int16_t)(uint16_t)(uint32_t)s; }
+
+// Material plus piece-square values, kept incrementally by Position like the Zobrist key
+class Psqt {
+public:
+    // Fill the tables (thread-safe, idempotent; also runs during static init)
+    static void init();
+
+    // Value of a piece on 'sq', positive for White and negative for Black
+    static Score value(bool isWhite, PieceType type, int sq) { return table[isWhite ? 0 : 1][(int)type][sq]; }
+    // Game phase weight of a piece (24 = all minor and major pieces on the board)
+    static int phase(PieceType type) { return PHASE_WEIGHT[(int)type]; }
+    static const int MAX_PHASE = 24;
+
+private:
+    static bool build();
+
+    static const int PHASE_WEIGHT[6];
+    static Score table[2][6][64];
+};
@@ -0,0 +1,60 @@
+#include "See.h"
+#include "Attacks.h"
+#include <algorithm>
+
+const int See::VALUE[6] = { 100, 500, 320, 330, 900, 20000 };
+
+// Least valuable first
+static const PieceType ORDER[6] = { PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP,
+                                    PieceType::ROOK, PieceType::QUEEN, PieceType::KING };
+
+int See::value(const Position& pos, Move m) {
+    if (m.kind() == MoveKind::CASTLING) return 0;
+    int from = m.from(), to = m.to();
+    bool white = pos.isWhiteAt(from);
+    Bitboard occ = pos.occupied() ^ squareBB(from);
+
+    // gain[d]: balance for the side making capture d if the exchange stopped right after it
+    int gain[32];
+    if (m.kind() == MoveKind::EN_PASSANT) {
+        gain[0] = VALUE[(int)PieceType::PAWN];
+        occ ^= squareBB(to + (white ? -8 : 8));
+    } else {
+        gain[0] = pos.isEmpty(to) ? 0 : VALUE[(int)pos.typeAt(to)];
+    }
+    PieceType onSquare = pos.typeAt(from);
+    if (m.kind() == MoveKind::PROMOTION) {
+        gain[0] += VALUE[(int)m.promotion()] - VALUE[(int)PieceType::PAWN];
+        onSquare = m.promotion();
+    }
+
+    Bitboard diagonal = pos.pieces(PieceType::BISHOP) | pos.pieces(PieceType::QUEEN);
+    Bitboard orthogonal = pos.pieces(PieceType::ROOK) | pos.pieces(PieceType::QUEEN);
+    Bitboard attackers = pos.attackersTo(to, occ) & occ;
+    bool side = !white;
+    int d = 0;
+    while (d < 31) {
+        Bitboard mine = attackers & pos.pieces(side);
+        if (!mine) break;
+        PieceType t = PieceType::KING;
+        Bitboard set = 0;
+        for (PieceType candidate : ORDER)
+            if ((set = mine & pos.pieces(candidate))) { t = candidate; break; }
+        // The king may only take last
+        if (t == PieceType::KING && (attackers & pos.pieces(!side))) break;
+        ++d;
+        gain[d] = VALUE[(int)onSquare] - gain[d - 1];
+        onSquare = t;
+        if (t == PieceType::PAWN && (rankOf(to) == 0 || rankOf(to) == 7)) {
+            gain[d] += VALUE[(int)PieceType::QUEEN] - VALUE[(int)PieceType::PAWN];
+            onSquare = PieceType::QUEEN;
+        }
+        occ ^= set & (0 - set); // one attacker of that type leaves its square
+        attackers |= (Attacks::bishop(to, occ) & diagonal) | (Attacks::rook(to, occ) & orthogonal);
+        attackers &= occ;
+        side = !side;
+    }
+    // Each side takes back only when that beats stopping
+    for (; d > 0; --d) gain[d - 1] = std::min(gain[d - 1], -gain[d]);
+    return gain[0];
+}
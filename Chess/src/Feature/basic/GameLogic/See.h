@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Position.h"
+
+// Static exchange evaluation: the material balance of the capture sequence on one square
+// when both sides always recapture with their least valuable attacker and may stop at any
+// point. Attackers hidden behind others (batteries, x-rays) join as the square clears;
+// pins are ignored.
+class See {
+public:
+    static const int VALUE[6]; // indexed by PieceType, centipawns; the king outweighs everything
+
+    // Net gain in centipawns for the side making m (0 for castling and quiet moves that
+    // cannot be won back; negative if the piece is lost for less)
+    static int value(const Position& pos, Move m);
+};
@@ -0,0 +1,477 @@
+#include "Tablebase.h"
+#include "Attacks.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+// One endgame: the strong side's men besides its king, in index order
+struct TbLayout {
+    const char* name;
+    PieceType pieces[2];
+    int count;
+    bool pawn;
+};
+
+static const TbLayout LAYOUTS[] = {
+    { "KQK",  { PieceType::QUEEN,  PieceType::PAWN },   1, false },
+    { "KRK",  { PieceType::ROOK,   PieceType::PAWN },   1, false },
+    { "KBNK", { PieceType::BISHOP, PieceType::KNIGHT }, 2, false },
+    { "KPK",  { PieceType::PAWN,   PieceType::PAWN },   1, true  },
+};
+
+struct Tablebase::Table {
+    const TbLayout* layout;
+    MappedFile file;
+    const unsigned char* bits;
+    uint64_t entries;
+    int width;
+};
+
+// File layout: 32-byte header, then entries packed 'width' bits each into little-endian words
+static const char MAGIC[8] = { 'C', '3', 'D', 'T', 'B', '0', '0', '1' };
+static const size_t HEADER_SIZE = 32;
+
+// Strong king squares of the pawnless fold: the a1-d1-d4 triangle
+static const int TRIANGLE[10] = { 0, 1, 2, 3, 9, 10, 11, 18, 19, 27 };
+
+// Strong side as White; piece[] follows the layout's order
+struct TbBoard {
+    int wk, bk;
+    int piece[2];
+    bool whiteToMove;
+};
+
+enum class TbChild : uint8_t { IN_TABLE, DRAW, PROMOTION };
+
+static const TbLayout* findLayout(const std::string& name) {
+    for (const TbLayout& t : LAYOUTS) if (name == t.name) return &t;
+    return nullptr;
+}
+
+static uint64_t tableSize(const TbLayout& t) {
+    uint64_t n = t.pawn ? 24 : 10;
+    for (int i = 0; i <= t.count; ++i) n *= 64;
+    return n * 2;
+}
+
+static int flipFile(int sq) { return sq ^ 7; }
+static int flipRank(int sq) { return sq ^ 56; }
+static int transpose(int sq) { return ((sq & 7) << 3) | (sq >> 3); }
+
+static void applyAll(const TbLayout& t, TbBoard& b, int (*f)(int)) {
+    b.wk = f(b.wk);
+    b.bk = f(b.bk);
+    for (int i = 0; i < t.count; ++i) b.piece[i] = f(b.piece[i]);
+}
+
+static void canonicalize(const TbLayout& t, TbBoard& b) {
+    if (t.pawn) {
+        if (fileOf(b.piece[0]) > 3) applyAll(t, b, flipFile);
+        return;
+    }
+    if (fileOf(b.wk) > 3) applyAll(t, b, flipFile);
+    if (rankOf(b.wk) > 3) applyAll(t, b, flipRank);
+    if (rankOf(b.wk) > fileOf(b.wk)) applyAll(t, b, transpose);
+}
+
+static uint64_t encode(const TbLayout& t, const TbBoard& b) {
+    uint64_t idx;
+    if (t.pawn) {
+        idx = ((uint64_t)((rankOf(b.piece[0]) - 1) * 4 + fileOf(b.piece[0])) * 64 + b.wk) * 64 + b.bk;
+    } else {
+        int tri = 0;
+        while (TRIANGLE[tri] != b.wk) ++tri;
+        idx = (uint64_t)tri * 64 + b.bk;
+        for (int i = 0; i < t.count; ++i) idx = idx * 64 + b.piece[i];
+    }
+    return idx * 2 + (b.whiteToMove ? 0 : 1);
+}
+
+static void decode(const TbLayout& t, uint64_t idx, TbBoard& b) {
+    b.whiteToMove = (idx & 1) == 0;
+    idx >>= 1;
+    if (t.pawn) {
+        b.bk = (int)(idx % 64); idx /= 64;
+        b.wk = (int)(idx % 64); idx /= 64;
+        b.piece[0] = squareOf((int)(idx % 4), (int)(idx / 4) + 1);
+        return;
+    }
+    for (int i = t.count - 1; i >= 0; --i) { b.piece[i] = (int)(idx % 64); idx /= 64; }
+    b.bk = (int)(idx % 64); idx /= 64;
+    b.wk = TRIANGLE[idx];
+}
+
+static Bitboard pieceAttacks(PieceType type, int sq, Bitboard occ) {
+    switch (type) {
+        case PieceType::PAWN:   return Attacks::pawn(true, sq);
+        case PieceType::KNIGHT: return Attacks::knight(sq);
+        case PieceType::BISHOP: return Attacks::bishop(sq, occ);
+        case PieceType::ROOK:   return Attacks::rook(sq, occ);
+        case PieceType::QUEEN:  return Attacks::queen(sq, occ);
+        default:                return Attacks::king(sq);
+    }
+}
+
+static Bitboard occupancy(const TbLayout& t, const TbBoard& b) {
+    Bitboard occ = squareBB(b.wk) | squareBB(b.bk);
+    for (int i = 0; i < t.count; ++i) occ |= squareBB(b.piece[i]);
+    return occ;
+}
+
+// Whether White attacks 'sq'; the man on 'skip' (a captured square, or -1) is ignored
+static bool whiteAttacks(const TbLayout& t, const TbBoard& b, int sq, Bitboard occ, int skip = -1) {
+    if (Attacks::king(b.wk) & squareBB(sq)) return true;
+    for (int i = 0; i < t.count; ++i)
+        if (b.piece[i] != skip && (pieceAttacks(t.pieces[i], b.piece[i], occ) & squareBB(sq))) return true;
+    return false;
+}
+
+static bool isLegal(const TbLayout& t, const TbBoard& b) {
+    Bitboard occ = occupancy(t, b);
+    if (popCount(occ) != 2 + t.count) return false;           // two men on one square
+    if (Attacks::king(b.wk) & squareBB(b.bk)) return false;   // touching kings
+    return !b.whiteToMove || !whiteAttacks(t, b, b.bk, occ);  // side not to move in check
+}
+
+// Calls f(child, kind, promotion) for every legal move until f returns false; returns the
+// number of moves visited. Black can only move its king; any capture leaves a drawn ending
+template <class F>
+static int forEachChild(const TbLayout& t, const TbBoard& b, F f) {
+    Bitboard occ = occupancy(t, b);
+    int n = 0;
+    TbBoard c = b;
+    c.whiteToMove = !b.whiteToMove;
+    if (!b.whiteToMove) {
+        Bitboard targets = Attacks::king(b.bk) & ~Attacks::king(b.wk) & ~squareBB(b.wk);
+        while (targets) {
+            int to = popLsb(targets);
+            int captured = (occ & squareBB(to)) ? to : -1;
+            Bitboard after = (occ & ~squareBB(b.bk)) | squareBB(to);
+            if (whiteAttacks(t, b, to, after, captured)) continue;
+            c.bk = to;
+            ++n;
+            if (!f(c, captured >= 0 ? TbChild::DRAW : TbChild::IN_TABLE, PieceType::PAWN)) return n;
+        }
+        return n;
+    }
+    // White: the lone king can neither check it nor be captured, so every move is legal
+    for (Bitboard targets = Attacks::king(b.wk) & ~occ & ~Attacks::king(b.bk); targets; ) {
+        c.wk = popLsb(targets);
+        ++n;
+        if (!f(c, TbChild::IN_TABLE, PieceType::PAWN)) return n;
+    }
+    c.wk = b.wk;
+    for (int i = 0; i < t.count; ++i) {
+        int from = b.piece[i];
+        Bitboard targets;
+        if (t.pieces[i] == PieceType::PAWN) {
+            targets = squareBB(from + 8) & ~occ;
+            if (targets && rankOf(from) == 1) targets |= squareBB(from + 16) & ~occ;
+        } else {
+            targets = pieceAttacks(t.pieces[i], from, occ) & ~occ;
+        }
+        while (targets) {
+            int to = popLsb(targets);
+            c.piece[i] = to;
+            if (t.pieces[i] == PieceType::PAWN && rankOf(to) == 7) {
+                static const PieceType PROMOTIONS[4] = { PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT };
+                for (PieceType p : PROMOTIONS) {
+                    ++n;
+                    if (!f(c, TbChild::PROMOTION, p)) return n;
+                }
+                continue;
+            }
+            ++n;
+            if (!f(c, TbChild::IN_TABLE, PieceType::PAWN)) return n;
+        }
+        c.piece[i] = from;
+    }
+    return n;
+}
+
+// Calls f(parent) for every legal position one move before b (no un-captures: those
+// parents have more material and belong to a bigger table)
+template <class F>
+static void forEachParent(const TbLayout& t, const TbBoard& b, F f) {
+    Bitboard occ = occupancy(t, b);
+    TbBoard p = b;
+    p.whiteToMove = !b.whiteToMove;
+    if (b.whiteToMove) {
+        // Black king came from a neighbouring square
+        for (Bitboard from = Attacks::king(b.bk) & ~occ & ~Attacks::king(b.wk); from; ) {
+            p.bk = popLsb(from);
+            f(p);
+        }
+        return;
+    }
+    auto emit = [&]() { if (!whiteAttacks(t, p, p.bk, occupancy(t, p))) f(p); };
+    for (Bitboard from = Attacks::king(b.wk) & ~occ & ~Attacks::king(b.bk); from; ) {
+        p.wk = popLsb(from);
+        emit();
+    }
+    p.wk = b.wk;
+    for (int i = 0; i < t.count; ++i) {
+        int to = b.piece[i];
+        Bitboard from;
+        if (t.pieces[i] == PieceType::PAWN) {
+            from = rankOf(to) >= 2 ? squareBB(to - 8) & ~occ : 0;
+            if (from && rankOf(to) == 3) from |= squareBB(to - 16) & ~occ;
+        } else {
+            from = pieceAttacks(t.pieces[i], to, occ) & ~occ;
+        }
+        while (from) {
+            p.piece[i] = popLsb(from);
+            emit();
+        }
+        p.piece[i] = to;
+    }
+}
+
+static uint64_t readWord(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+static int readCode(const Tablebase::Table& tb, uint64_t idx) {
+    uint64_t bit = idx * (uint64_t)tb.width;
+    const unsigned char* w = tb.bits + (bit >> 6) * 8;
+    int shift = (int)(bit & 63);
+    uint64_t v = readWord(w) >> shift;
+    if (shift + tb.width > 64) v |= readWord(w + 8) << (64 - shift);
+    return (int)(v & ((1u << tb.width) - 1));
+}
+
+static int boardCode(const Tablebase::Table& tb, TbBoard b) {
+    canonicalize(*tb.layout, b);
+    return readCode(tb, encode(*tb.layout, b));
+}
+
+const std::vector<std::string>& Tablebase::names() {
+    static const std::vector<std::string> all = { "KQK", "KRK", "KBNK", "KPK" };
+    return all;
+}
+
+Tablebase::Tablebase() {}
+Tablebase::~Tablebase() {}
+
+const Tablebase::Table* Tablebase::find(const std::string& name) const {
+    for (const auto& t : tables) if (name == t->layout->name) return t.get();
+    return nullptr;
+}
+
+bool Tablebase::has(const std::string& name) const {
+    return find(name) != nullptr;
+}
+
+int Tablebase::load(const std::string& dir) {
+    int loaded = 0;
+    for (const TbLayout& layout : LAYOUTS) {
+        std::unique_ptr<Table> t(new Table());
+        t->layout = &layout;
+        if (!t->file.open(dir + "/" + layout.name + ".ctb") || t->file.size() < HEADER_SIZE) continue;
+        if (!t->file.map(0, (size_t)t->file.size())) continue;
+        const unsigned char* h = (const unsigned char*)t->file.data();
+        char name[9] = { 0 };
+        std::copy(h + 8, h + 16, name);
+        t->entries = readWord(h + 16);
+        t->width = h[24];
+        uint64_t words = (t->entries * t->width + 63) / 64 + 1;
+        if (!std::equal(MAGIC, MAGIC + 8, (const char*)h) || std::string(name) != layout.name || t->entries != tableSize(layout)
+            || t->width < 1 || t->width > 8 || t->file.size() < HEADER_SIZE + words * 8)
+            continue;
+        t->bits = h + HEADER_SIZE;
+        tables.erase(std::remove_if(tables.begin(), tables.end(), [&](const std::unique_ptr<Table>& o) { return o->layout == &layout; }),
+                     tables.end());
+        tables.push_back(std::move(t));
+        ++loaded;
+    }
+    return loaded;
+}
+
+bool Tablebase::probe(const Position& pos, TbResult& out) const {
+    if (pos.castlingRights() || popCount(pos.occupied()) > 4) return false;
+    Bitboard kings = pos.pieces(PieceType::KING);
+    Bitboard white = pos.pieces(true) & ~kings, black = pos.pieces(false) & ~kings;
+    if (white && black) return false;
+    Bitboard extra = white | black;
+    Bitboard minors = pos.pieces(PieceType::BISHOP) | pos.pieces(PieceType::KNIGHT);
+    if (!extra || (popCount(extra) == 1 && (extra & minors))) { out = TbResult(); return true; } // no mating material
+
+    bool strongWhite = white != 0;
+    for (const auto& tb : tables) {
+        const TbLayout& t = *tb->layout;
+        if (t.count != popCount(extra)) continue;
+        TbBoard b;
+        Bitboard left = extra;
+        bool match = true;
+        for (int i = 0; i < t.count && match; ++i) {
+            Bitboard m = left & pos.pieces(t.pieces[i]);
+            if (!m) { match = false; break; }
+            b.piece[i] = lsbIndex(m);
+            left &= ~squareBB(b.piece[i]);
+        }
+        if (!match) continue;
+        b.wk = pos.kingSquare(strongWhite);
+        b.bk = pos.kingSquare(!strongWhite);
+        b.whiteToMove = pos.whiteToMove() == strongWhite;
+        if (!strongWhite) applyAll(t, b, flipRank); // colour swap: the strong side always plays up the board
+        int code = boardCode(*tb, b);
+        out.dtm = code ? code - 1 : 0;
+        out.wdl = code == 0 ? TbWdl::DRAW : (out.dtm & 1) ? TbWdl::WIN : TbWdl::LOSS;
+        return true;
+    }
+    return false;
+}
+
+bool Tablebase::generate(const std::string& name, const std::string& dir, ThreadPool& pool, std::string& error, TbGenStats* stats) {
+    const TbLayout* layout = findLayout(name);
+    if (!layout) { error = "unknown endgame " + name; return false; }
+    const TbLayout& t = *layout;
+    const Table* queenTable = find("KQK");
+    const Table* rookTable = find("KRK");
+    if (t.pawn && (!queenTable || !rookTable)) { error = name + " needs the KQK and KRK tables"; return false; }
+    Attacks::init();
+    auto t0 = std::chrono::steady_clock::now();
+
+    const uint64_t n = tableSize(t);
+    std::unique_ptr<std::atomic<uint8_t>[]> value(new std::atomic<uint8_t>[n]);
+    std::atomic<int> highest(0);
+    auto raise = [&](int code) {
+        int h = highest.load(std::memory_order_relaxed);
+        while (code > h && !highest.compare_exchange_weak(h, code)) {}
+    };
+    auto parallel = [&](const std::function<void(uint64_t, uint64_t)>& body) {
+        const uint64_t chunk = 1 << 14;
+        for (uint64_t begin = 0; begin < n; begin += chunk) {
+            uint64_t end = std::min(begin + chunk, n);
+            pool.enqueue([&body, begin, end] { body(begin, end); });
+        }
+        pool.wait();
+    };
+
+    // Mates, and wins through promotion into an already solved table
+    parallel([&](uint64_t begin, uint64_t end) {
+        for (uint64_t i = begin; i < end; ++i) {
+            value[i].store(0, std::memory_order_relaxed);
+            TbBoard b;
+            decode(t, i, b);
+            if (!isLegal(t, b)) continue;
+            int best = 0;
+            int moves = forEachChild(t, b, [&](const TbBoard& c, TbChild kind, PieceType promotion) {
+                if (kind != TbChild::PROMOTION) return true;
+                const Table* target = promotion == PieceType::QUEEN ? queenTable : promotion == PieceType::ROOK ? rookTable : nullptr;
+                if (!target) return true; // a minor piece cannot mate
+                int code = boardCode(*target, c);
+                if (code && (code - 1) % 2 == 0 && (!best || code + 1 < best)) best = code + 1;
+                return true;
+            });
+            if (moves == 0 && !b.whiteToMove && whiteAttacks(t, b, b.bk, occupancy(t, b))) best = 1; // mated
+            if (best) { value[i].store((uint8_t)best, std::memory_order_relaxed); raise(best); }
+        }
+    });
+
+    // Pawnless folds keep both diagonal mirrors when the strong king is on a1-d4; each
+    // stands for the other, so every update is applied to both
+    auto forEachTwin = [&](TbBoard p, const std::function<void(const TbBoard&, uint64_t)>& f) {
+        canonicalize(t, p);
+        f(p, encode(t, p));
+        if (!t.pawn && rankOf(p.wk) == fileOf(p.wk)) {
+            TbBoard q = p;
+            applyAll(t, q, transpose);
+            uint64_t qi = encode(t, q);
+            if (qi != encode(t, p)) f(q, qi);
+        }
+    };
+
+    // Retrograde sweep, one ply level at a time: parents of positions lost in d plies win in
+    // d+1; a parent of a position won in d plies loses in d+1 once all its moves are known wins
+    for (int d = 0; d + 1 <= highest.load(); ++d) {
+        const uint8_t code = (uint8_t)(d + 1);
+        const bool lossLevel = d % 2 == 0;
+        parallel([&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i) {
+                if (value[i].load(std::memory_order_relaxed) != code) continue;
+                TbBoard b;
+                decode(t, i, b);
+                forEachParent(t, b, [&](const TbBoard& parent) {
+                    forEachTwin(parent, [&](const TbBoard& p, uint64_t q) {
+                        uint8_t cur = value[q].load(std::memory_order_relaxed);
+                        if (lossLevel) {
+                            // Keep the shortest win (a promotion may have set a longer one)
+                            while (cur == 0 || cur > code + 1) {
+                                if (value[q].compare_exchange_weak(cur, (uint8_t)(code + 1))) { raise(code + 1); break; }
+                            }
+                            return;
+                        }
+                        if (cur != 0) return;
+                        bool allWin = true;
+                        forEachChild(t, p, [&](const TbBoard& c, TbChild kind, PieceType) {
+                            if (kind != TbChild::IN_TABLE) { allWin = false; return false; }
+                            TbBoard cc = c;
+                            canonicalize(t, cc);
+                            int cv = value[encode(t, cc)].load(std::memory_order_relaxed);
+                            allWin = cv != 0 && cv <= code && (cv - 1) % 2 == 1;
+                            return allWin;
+                        });
+                        uint8_t expected = 0;
+                        if (allWin && value[q].compare_exchange_strong(expected, (uint8_t)(code + 1))) raise(code + 1);
+                    });
+                });
+            }
+        });
+    }
+
+    // Pack and write
+    int maxCode = highest.load();
+    int width = 1;
+    while ((1 << width) <= maxCode) ++width;
+    uint64_t words = (n * width + 63) / 64 + 1;
+    std::vector<uint64_t> packed(words, 0);
+    uint64_t counts[3] = { 0, 0, 0 }; // loss, draw, win
+    for (uint64_t i = 0; i < n; ++i) {
+        uint64_t v = value[i].load(std::memory_order_relaxed);
+        TbBoard b;
+        decode(t, i, b);
+        if (isLegal(t, b)) ++counts[v == 0 ? 1 : (v - 1) % 2 == 1 ? 2 : 0];
+        if (!v) continue;
+        uint64_t bit = i * width;
+        packed[bit >> 6] |= v << (bit & 63);
+        if ((bit & 63) + width > 64) packed[(bit >> 6) + 1] |= v >> (64 - (bit & 63));
+    }
+    value.reset();
+
+    std::string path = dir + "/" + name + ".ctb";
+    {
+        std::ofstream f(path, std::ios::binary);
+        unsigned char header[HEADER_SIZE] = { 0 };
+        std::copy(MAGIC, MAGIC + 8, header);
+        std::copy(name.begin(), name.end(), header + 8);
+        for (int k = 0; k < 8; ++k) header[16 + k] = (unsigned char)(n >> (8 * k));
+        header[24] = (unsigned char)width;
+        header[25] = (unsigned char)(maxCode ? maxCode - 1 : 0);
+        f.write((const char*)header, HEADER_SIZE);
+        for (uint64_t w : packed) {
+            unsigned char bytes[8];
+            for (int k = 0; k < 8; ++k) bytes[k] = (unsigned char)(w >> (8 * k));
+            f.write((const char*)bytes, 8);
+        }
+        if (!f) { error = "cannot write " + path; return false; }
+    }
+    if (!load(dir) || !has(name)) { error = "cannot map " + path; return false; }
+
+    if (stats) {
+        stats->entries = n;
+        stats->losses = counts[0];
+        stats->draws = counts[1];
+        stats->wins = counts[2];
+        stats->maxDtm = maxCode ? maxCode - 1 : 0;
+        stats->bits = width;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Position.h"
+
+class ThreadPool;
+
+// Exact value of an endgame position for the side to move
+enum class TbWdl : int8_t { LOSS = -1, DRAW = 0, WIN = 1 };
+
+struct TbResult {
+    TbWdl wdl = TbWdl::DRAW;
+    int dtm = 0;   // plies to mate with best play (0 when drawn, or when mated already)
+};
+
+// Summary of one generated table
+struct TbGenStats {
+    uint64_t entries = 0;                  // index slots, including impossible placements
+    uint64_t wins = 0, draws = 0, losses = 0; // legal positions by value for the side to move
+    int maxDtm = 0;
+    int bits = 0;                          // bits per packed entry
+    double seconds = 0.0;
+};
+
+// Endgame tablebases for a lone king against KQ, KR, KP and KBN, built in-process by
+// retrograde analysis. Positions are indexed with the strong side as White; pawnless
+// tables fold the board so the strong king stands in the a1-d1-d4 triangle, the KPK table
+// mirrors the pawn onto files a-d. Each entry packs win/draw/loss and distance-to-mate
+// into a few bits: 0 is a draw, otherwise dtm + 1 (odd dtm wins, even dtm loses).
+// Tables live in "<name>.ctb" files that are memory-mapped, so a probe is one index
+// computation and one bit-field read.
+class Tablebase {
+public:
+    // Names of the supported endgames, in generation order (KPK promotes into KQK/KRK)
+    static const std::vector<std::string>& names();
+
+    Tablebase();
+    ~Tablebase();
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+
+    // Map "<dir>/<name>.ctb" for every supported endgame that exists; returns how many
+    int load(const std::string& dir);
+    bool has(const std::string& name) const;
+    int tableCount() const { return (int)tables.size(); }
+
+    // Value of pos if its material is covered (trivially drawn K v K and K+minor v K included).
+    // Positions with castling rights are never covered
+    bool probe(const Position& pos, TbResult& out) const;
+
+    // Build one endgame on 'pool' and write "<dir>/<name>.ctb", then map it. KPK needs KQK
+    // and KRK loaded first. Returns false with 'error' set on failure
+    bool generate(const std::string& name, const std::string& dir, ThreadPool& pool, std::string& error,
+                  TbGenStats* stats = nullptr);
+
+    struct Table;
+private:
+    const Table* find(const std::string& name) const;
+    std::vector<std::unique_ptr<Table>> tables;
+};
@@ -0,0 +1,98 @@
+#include "TranspositionTable.h"
+#include <new>
+
+TranspositionTable::TranspositionTable(size_t megabytes) : buckets(nullptr), bucketCount(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t target = (megabytes ? megabytes : 1) * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= target) count *= 2;
+
+    memory.reset(new char[count * sizeof(Bucket) + alignof(Bucket)]);
+    uintptr_t raw = reinterpret_cast<uintptr_t>(memory.get());
+    buckets = reinterpret_cast<Bucket*>((raw + alignof(Bucket) - 1) & ~(uintptr_t)(alignof(Bucket) - 1));
+    for (size_t i = 0; i < count; ++i) new (&buckets[i]) Bucket();
+    bucketCount = count;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i)
+        for (int j = 0; j < Bucket::SIZE; ++j) {
+            buckets[i].slots[j].check.store(0, std::memory_order_relaxed);
+            buckets[i].slots[j].data.store(0, std::memory_order_relaxed);
+        }
+    generation = 0;
+}
+
+uint64_t TranspositionTable::pack(Move move, int score, int eval, int depth, uint8_t genBound) {
+    return (uint64_t)move.data
+         | (uint64_t)(uint16_t)score << 16
+         | (uint64_t)(uint16_t)eval << 32
+         | (uint64_t)(uint8_t)(depth < 0 ? 0 : depth > 255 ? 255 : depth) << 48
+         | (uint64_t)genBound << 56;
+}
+
+TTEntry TranspositionTable::unpack(uint64_t key, uint64_t data) {
+    TTEntry e;
+    e.key = key;
+    e.move.data = (uint16_t)data;
+    e.score = (int16_t)(uint16_t)(data >> 16);
+    e.eval = (int16_t)(uint16_t)(data >> 32);
+    e.depth = (uint8_t)(data >> 48);
+    e.genBound = (uint8_t)(data >> 56);
+    return e;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& out) const {
+    const Bucket& b = bucketFor(key);
+    for (int i = 0; i < Bucket::SIZE; ++i) {
+        uint64_t data = b.slots[i].data.load(std::memory_order_relaxed);
+        uint64_t check = b.slots[i].check.load(std::memory_order_relaxed);
+        // Torn or foreign slots fail the XOR check; empty slots have no bound
+        if ((check ^ data) == key && (data >> 56 & 3) != (uint64_t)Bound::NONE) {
+            out = unpack(key, data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int score, int eval, int depth, Bound bound) {
+    Bucket& b = bucketFor(key);
+    Slot* slot = &b.slots[0];
+    uint64_t slotData = 0;
+    bool sameKey = false;
+    int worst = 1 << 30;
+    for (int i = 0; i < Bucket::SIZE; ++i) {
+        Slot& s = b.slots[i];
+        uint64_t data = s.data.load(std::memory_order_relaxed);
+        uint64_t check = s.check.load(std::memory_order_relaxed);
+        sameKey = (check ^ data) == key;
+        if (sameKey || (data >> 56 & 3) == (uint64_t)Bound::NONE) { slot = &s; slotData = data; break; }
+        // Prefer replacing stale generations first, then shallow entries
+        uint8_t genBound = (uint8_t)(data >> 56);
+        int age = ((generation - (genBound & 0xFC)) & 0xFF) >> 2;
+        int value = (int)(uint8_t)(data >> 48) - 8 * age;
+        if (value < worst) { worst = value; slot = &s; slotData = data; }
+    }
+    // Keep the old best move when the new result has none for the same position
+    if (move.isNone() && sameKey) move.data = (uint16_t)slotData;
+
+    uint64_t data = pack(move, score, eval, depth, (uint8_t)(generation | (uint8_t)bound));
+    slot->check.store(key ^ data, std::memory_order_relaxed);
+    slot->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    size_t samples = bucketCount < 250 ? bucketCount : 250;
+    int used = 0;
+    for (size_t i = 0; i < samples; ++i)
+        for (int j = 0; j < Bucket::SIZE; ++j) {
+            uint8_t genBound = (uint8_t)(buckets[i].slots[j].data.load(std::memory_order_relaxed) >> 56);
+            if ((genBound & 3) != (uint8_t)Bound::NONE && (genBound & 0xFC) == generation) ++used;
+        }
+    return (int)(used * 1000 / (samples * Bucket::SIZE));
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Move.h"
+
+// Which side of the search window a stored score came from
+enum class Bound : uint8_t { NONE = 0, UPPER = 1, LOWER = 2, EXACT = 3 };
+
+// Unpacked copy of one table slot, as returned by probe()
+struct TTEntry {
+    uint64_t key = 0;
+    Move move;
+    int16_t score = 0;
+    int16_t eval = 0;
+    uint8_t depth = 0;
+    uint8_t genBound = 0;   // generation in the top 6 bits, Bound in the low 2
+
+    Bound bound() const { return (Bound)(genBound & 3); }
+};
+
+// Fixed-size hash table keyed on Position::key(); a probe touches a single cache line.
+// Safe to share between search threads without locks: each slot stores key ^ data
+// next to data, so a slot torn by a concurrent write fails verification and reads as a miss.
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    // Reallocate (rounded down to a power-of-two bucket count) and clear; not thread-safe
+    void resize(size_t megabytes);
+    void clear();
+    // Age existing entries so the next search prefers replacing them
+    void newSearch() { generation = (uint8_t)(generation + 4); }
+
+    bool probe(uint64_t key, TTEntry& out) const;
+    void store(uint64_t key, Move move, int score, int eval, int depth, Bound bound);
+
+    // Permille of sampled slots written during the current generation
+    int hashfull() const;
+    size_t sizeInBytes() const { return bucketCount * sizeof(Bucket); }
+
+private:
+    // 16-byte slot; four of them fill one 64-byte cache line
+    struct Slot {
+        std::atomic<uint64_t> check;   // key ^ data
+        std::atomic<uint64_t> data;    // packed move, score, eval, depth, genBound
+    };
+    struct alignas(64) Bucket {
+        static const int SIZE = 4;
+        Slot slots[SIZE];
+    };
+
+    static uint64_t pack(Move move, int score, int eval, int depth, uint8_t genBound);
+    static TTEntry unpack(uint64_t key, uint64_t data);
+
+    Bucket& bucketFor(uint64_t key) const { return buckets[key & (bucketCount - 1)]; }
+
+    std::unique_ptr<char[]> memory;   // over-allocated so buckets start on a cache line
+    Bucket* buckets;
+    size_t bucketCount;
+    uint8_t generation;
+};
@@ -0,0 +1,37 @@
+#include "Zobrist.h"
+
+uint64_t Zobrist::pieceKeys[2][6][64];
+uint64_t Zobrist::castlingKeys[16];
+uint64_t Zobrist::epFileKeys[8];
+uint64_t Zobrist::sideKey;
+
+static struct ZobristStartup { ZobristStartup() { Zobrist::init(); } } zobristStartup;
+
+void Zobrist::init() {
+    static const bool ready = build();
+    (void)ready;
+}
+
+bool Zobrist::build() {
+    // splitmix64 with a fixed seed: keys are identical across runs and builds
+    uint64_t s = 0x2545F4914F6CDD1DULL;
+    auto next = [&s]() {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (int c = 0; c < 2; ++c)
+        for (int t = 0; t < 6; ++t)
+            for (int sq = 0; sq < 64; ++sq) pieceKeys[c][t][sq] = next();
+    // Each right gets one key; combined rights are the XOR of their bits
+    uint64_t rightKeys[4];
+    for (int i = 0; i < 4; ++i) rightKeys[i] = next();
+    for (int r = 0; r < 16; ++r) {
+        castlingKeys[r] = 0;
+        for (int i = 0; i < 4; ++i) if (r & (1 << i)) castlingKeys[r] ^= rightKeys[i];
+    }
+    for (int f = 0; f < 8; ++f) epFileKeys[f] = next();
+    sideKey = next();
+    return true;
+}
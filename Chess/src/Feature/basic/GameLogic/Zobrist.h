@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include "CoreTypes.h"
+
+// Random 64-bit keys for incremental position hashing
+class Zobrist {
+public:
+    // Fill the key tables (thread-safe, idempotent; also runs during static init)
+    static void init();
+
+    static uint64_t piece(bool isWhite, PieceType type, int sq) { return pieceKeys[isWhite ? 0 : 1][(int)type][sq]; }
+    static uint64_t castling(uint8_t rights) { return castlingKeys[rights & 15]; }
+    static uint64_t enPassant(int sq) { return sq < 0 ? 0 : epFileKeys[sq & 7]; }
+    static uint64_t side() { return sideKey; } // xored in when black is to move
+
+private:
+    static bool build();
+
+    static uint64_t pieceKeys[2][6][64];
+    static uint64_t castlingKeys[16];
+    static uint64_t epFileKeys[8];
+    static uint64_t sideKey;
+};
@@ -1,5 +1,6 @@
 #include "MoveObject.h"
 #include "../GameLogic/GameLogic.h"
+#include "../GameLogic/BoardSync.h"
 #include "../CameraControl/CameraControl.h"
 #include <iostream>
 #include <glm/glm.hpp>
@@ -48,12 +49,12 @@ bool MoveObject::checkArrowKeyEdge(GLFWwindow* window, int& dx, int& dy, bool bo
     return stepped;
 }
 
-void MoveObject::updateCursorPosition(ChessSquare& cursorPos, int dx, int dy, const std::vector<Piece>& pieces, int& selectedPiece) {
+void MoveObject::updateCursorPosition(ChessSquare& cursorPos, int dx, int dy, const Position& game, int& selectedPiece) {
     cursorPos.file = glm::clamp(cursorPos.file + dx, 0, 7);
     cursorPos.rank = glm::clamp(cursorPos.rank + dy, 0, 7);
     
-    // Find piece at new position
-    selectedPiece = findPieceAtPosition(cursorPos, pieces);
+    // Scene piece indices are the Position's piece indices (see BoardSync)
+    selectedPiece = game.pieceIndexAt(squareOf(cursorPos.file, cursorPos.rank));
 }
 
 int MoveObject::findPieceAtPosition(const ChessSquare& pos, const std::vector<Piece>& pieces) {
@@ -100,17 +101,16 @@ void MoveObject::handleShiftMovement(GLFWwindow* window, bool boardFlipped, Ches
     }
 }
 
-bool MoveObject::validateMove(const std::vector<Piece>& pieces, int selectedPiece, const ChessSquare& from, const ChessSquare& to, bool whitesTurn) {
-    if (selectedPiece < 0 || selectedPiece >= (int)pieces.size()) return false;
-    if (pieces[selectedPiece].isWhite != whitesTurn) return false;
-    
-    return GameLogic::canCommitMove(pieces, selectedPiece, from, to, whitesTurn);
+bool MoveObject::validateMove(const Position& game, const ChessSquare& from, const ChessSquare& to) {
+    return GameLogic::canCommitMove(game, from, to);
 }
 
-void MoveObject::executeMove(std::vector<Piece>& pieces, int selectedPiece, const ChessSquare& from, const ChessSquare& to, 
-                           bool& whitesTurn, bool& boardFlipped, Camera& camera, int& savedSelWhite, int& savedSelBlack, 
+bool MoveObject::executeMove(Position& game, std::vector<Piece>& pieces, int& selectedPiece, const ChessSquare& from, const ChessSquare& to, 
+                           bool& boardFlipped, Camera& camera, int& savedSelWhite, int& savedSelBlack, 
                            ChessSquare& savedCursorWhite, ChessSquare& savedCursorBlack, ChessSquare& cursorPos) {
-    if (selectedPiece < 0 || selectedPiece >= (int)pieces.size()) return;
+    // Auto-queen, as everywhere in the keyboard UI
+    Move m = GameLogic::findLegalMove(game, from, to, PieceType::QUEEN);
+    if (m.isNone()) return false;
     
     auto updatePieceModel = [&](Piece& p){
         glm::mat4 m(1.0f);
@@ -118,92 +118,19 @@ void MoveObject::executeMove(std::vector<Piece>& pieces, int selectedPiece, cons
         float scaleByType = (p.type == PieceType::PAWN) ? 0.15f : 0.2f;
         p.model = glm::scale(m, glm::vec3(scaleByType));
     };
-    auto captureIfEnemyAt = [&](int targetFile, int targetRank, int selfIndex)->int {
-        for (int i = 0; i < (int)pieces.size(); ++i) {
-            if (i == selfIndex) continue;
-            if (pieces[i].file == targetFile && pieces[i].rank == targetRank && pieces[i].isWhite != pieces[selfIndex].isWhite) {
-                GameLogic::markCaptured(pieces, i);
-                return i;
-            }
-        }
-        return -1;
-    };
     
-    // Handle capture if enemy present
-    captureIfEnemyAt(to.file, to.rank, selectedPiece);
-    
-    bool movingWasWhite = pieces[selectedPiece].isWhite;
-    
-    // Castling rook move if king moved two squares
-    if (pieces[selectedPiece].type == PieceType::KING && abs(to.file - from.file) == 2) {
-        int rr = from.rank;
-        if (to.file > from.file) {
-            // king side: move rook from 7 to 5
-            for (int i = 0; i < (int)pieces.size(); ++i) {
-                if (pieces[i].type == PieceType::ROOK && pieces[i].isWhite == movingWasWhite && pieces[i].rank == rr && pieces[i].file == 7) {
-                    pieces[i].file = 5;
-                    pieces[i].hasMoved = true;
-                    updatePieceModel(pieces[i]);
-                    break;
-                }
-            }
-        } else {
-            // queen side: move rook from 0 to 3
-            for (int i = 0; i < (int)pieces.size(); ++i) {
-                if (pieces[i].type == PieceType::ROOK && pieces[i].isWhite == movingWasWhite && pieces[i].rank == rr && pieces[i].file == 0) {
-                    pieces[i].file = 3;
-                    pieces[i].hasMoved = true;
-                    updatePieceModel(pieces[i]);
-                    break;
-                }
-            }
-        }
-    }
-    
-    // En-passant capture if pawn moved to enPassantSquare
-    if (pieces[selectedPiece].type == PieceType::PAWN && GameLogic::enPassantAvailable && 
-        to.file == GameLogic::enPassantSquare.file && to.rank == GameLogic::enPassantSquare.rank) {
-        int dir = movingWasWhite ? 1 : -1;
-        int victimRank = to.rank - dir;
-        for (int i = 0; i < (int)pieces.size(); ++i) {
-            if (pieces[i].file == to.file && pieces[i].rank == victimRank && pieces[i].type == PieceType::PAWN && pieces[i].isWhite != movingWasWhite) {
-                GameLogic::markCaptured(pieces, i);
-                break;
-            }
-        }
-    }
-    
-    // Update piece
-    pieces[selectedPiece].file = to.file;
-    pieces[selectedPiece].rank = to.rank;
-    pieces[selectedPiece].hasMoved = true;
-    updatePieceModel(pieces[selectedPiece]);
-    
-    // Pawn promotion (auto-queen)
-    if (pieces[selectedPiece].type == PieceType::PAWN && 
-        ((movingWasWhite && pieces[selectedPiece].rank == 7) || (!movingWasWhite && pieces[selectedPiece].rank == 0))) {
-        pieces[selectedPiece].type = PieceType::QUEEN;
-        updatePieceModel(pieces[selectedPiece]);
-    }
-    
-    // Update en-passant availability for next move
-    GameLogic::enPassantAvailable = false;
-    GameLogic::enPassantVictimIndex = -1;
-    if (pieces[selectedPiece].type == PieceType::PAWN && abs(to.rank - from.rank) == 2) {
-        GameLogic::enPassantAvailable = true;
-        GameLogic::enPassantVictimIndex = selectedPiece;
-        GameLogic::enPassantSquare = ChessSquare(from.file, (from.rank + to.rank)/2);
-    }
+    // The Position resolves captures, the castling rook, en passant and promotion;
+    // the scene pieces just follow it
+    game.makeMove(m);
+    BoardSync::syncPieces(game, pieces);
+    for (Piece& p : pieces) if (GameLogic::isValidSquare(p.file, p.rank)) updatePieceModel(p);
     
     // Flip orientation after each move
     boardFlipped = !boardFlipped;
     CameraControl::setCameraMode(camera, CameraControl::getCurrentCameraMode(), boardFlipped);
     
-    // Set side to move to the opposite of the piece that just moved
-    whitesTurn = !movingWasWhite;
-    
     // Switch highlight to side-to-move last piece or default
-    if (whitesTurn) {
+    if (game.whiteToMove()) {
         if (savedSelWhite >= 0) {
             selectedPiece = savedSelWhite;
             cursorPos = savedCursorWhite;
@@ -222,6 +149,7 @@ void MoveObject::executeMove(std::vector<Piece>& pieces, int selectedPiece, cons
             cursorPos = defB;
         }
     }
+    return true;
 }
 
 void MoveObject::updatePressedStates(bool left, bool right, bool up, bool down, bool shift) {
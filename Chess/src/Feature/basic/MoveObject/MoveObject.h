@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "../GameLogic/Types.h"
+#include "../GameLogic/Position.h"
 
 class Camera; // Forward declaration
 
@@ -13,18 +14,18 @@ public:
     static bool isArrowKeyPressed(GLFWwindow* window, int& dx, int& dy, bool boardFlipped);
     static bool checkArrowKeyEdge(GLFWwindow* window, int& dx, int& dy, bool boardFlipped);
     
-    // Cursor navigation
-    static void updateCursorPosition(ChessSquare& cursorPos, int dx, int dy, const std::vector<Piece>& pieces, int& selectedPiece);
+    // Cursor navigation; the piece under the cursor comes from the game Position's mailbox
+    static void updateCursorPosition(ChessSquare& cursorPos, int dx, int dy, const Position& game, int& selectedPiece);
     static int findPieceAtPosition(const ChessSquare& pos, const std::vector<Piece>& pieces);
     
     // SHIFT-based movement
     static void handleShiftMovement(GLFWwindow* window, bool boardFlipped, ChessSquare& pendingTarget, bool& hasPendingTarget, 
                                    ChessSquare& pendingStart, int& accumDx, int& accumDy, const std::vector<Piece>& pieces, int selectedPiece);
     
-    // Move validation and execution
-    static bool validateMove(const std::vector<Piece>& pieces, int selectedPiece, const ChessSquare& from, const ChessSquare& to, bool whitesTurn);
-    static void executeMove(std::vector<Piece>& pieces, int selectedPiece, const ChessSquare& from, const ChessSquare& to, 
-                           bool& whitesTurn, bool& boardFlipped, Camera& camera, int& savedSelWhite, int& savedSelBlack, 
+    // Move validation and execution against the game Position (side to move comes from 'game')
+    static bool validateMove(const Position& game, const ChessSquare& from, const ChessSquare& to);
+    static bool executeMove(Position& game, std::vector<Piece>& pieces, int& selectedPiece, const ChessSquare& from, const ChessSquare& to, 
+                           bool& boardFlipped, Camera& camera, int& savedSelWhite, int& savedSelBlack, 
                            ChessSquare& savedCursorWhite, ChessSquare& savedCursorBlack, ChessSquare& cursorPos);
     
     // State management
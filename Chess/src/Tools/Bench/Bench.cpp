@@ -0,0 +1,145 @@
+// chess_bench: microbenchmarks of the headless rules library (ChessCore)
+//
+// Usage: chess_bench [google benchmark flags, e.g. --benchmark_filter=Status]
+// Times legal move generation, make/unmake, per-move legality checks, game status
+// detection and the AI's static evaluation on a fixed position suite. Results are written as JSON to
+// stdout unless another --benchmark_format is given.
+
+#include "Feature/basic/GameLogic/GameLogic.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "Feature/advanced/AI/Evaluate.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct BenchCase {
+    const char* name;
+    const char* fen;
+};
+
+static const BenchCase SUITE[] = {
+    { "startpos",   "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" },
+    { "kiwipete",   "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1" },
+    { "middlegame", "r2q1rk1/ppp2ppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP2PPP/R2Q1RK1 w - - 0 8" },
+    { "promotions", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1" },
+    { "endgame-ep", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1" },
+    { "mated",      "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3" },
+};
+static const int SUITE_SIZE = (int)(sizeof(SUITE) / sizeof(SUITE[0]));
+
+static Position loadCase(benchmark::State& state) {
+    const BenchCase& c = SUITE[state.range(0)];
+    state.SetLabel(c.name);
+    Position pos;
+    if (!Notation::setFromFEN(pos, c.fen)) state.SkipWithError("invalid FEN");
+    return pos;
+}
+
+// Full legal move list of the side to move
+static void BM_GenerateLegal(benchmark::State& state) {
+    Position pos = loadCase(state);
+    MoveList moves;
+    for (auto _ : state) {
+        moves.clear();
+        MoveGen::generateLegal(pos, moves);
+        benchmark::DoNotOptimize(moves.size());
+    }
+    state.SetItemsProcessed(state.iterations() * moves.size());
+}
+
+// makeMove/unmakeMove of every legal move (incremental Zobrist key included)
+static void BM_MakeUnmake(benchmark::State& state) {
+    Position pos = loadCase(state);
+    MoveList moves;
+    MoveGen::generateLegal(pos, moves);
+    for (auto _ : state) {
+        for (const Move& m : moves) {
+            pos.makeMove(m);
+            benchmark::DoNotOptimize(pos.key());
+            pos.unmakeMove();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * moves.size());
+}
+
+// Pseudo-legal generation plus the UI's per-move legality check, for every piece of the mover
+static void BM_LegalityCheck(benchmark::State& state) {
+    Position pos = loadCase(state);
+    int64_t checks = 0;
+    for (auto _ : state) {
+        for (Bitboard own = pos.pieces(pos.whiteToMove()); own; ) {
+            int sq = popLsb(own);
+            ChessSquare from(fileOf(sq), rankOf(sq));
+            MoveList moves;
+            GameLogic::getAllowableMoves(pos, from, moves);
+            for (const Move& m : moves) {
+                benchmark::DoNotOptimize(GameLogic::wouldBeLegalMove(pos, from, ChessSquare(fileOf(m.to()), rankOf(m.to()))));
+                ++checks;
+            }
+        }
+    }
+    state.SetItemsProcessed(checks);
+}
+
+// Check flags, mate/stalemate and both sides' legal moves, as rebuilt after every game move
+static void BM_ComputeStatus(benchmark::State& state) {
+    Position pos = loadCase(state);
+    GameStatus status;
+    for (auto _ : state) {
+        GameLogic::computeStatus(pos, status);
+        benchmark::DoNotOptimize(status.stalemate);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Static evaluation (evaluations/second): incremental material/PST plus the SIMD kernel
+static void BM_Evaluate(benchmark::State& state) {
+    Position pos = loadCase(state);
+    for (auto _ : state) benchmark::DoNotOptimize(Evaluate::evaluate(pos));
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Same with the scalar mobility/pawn-structure kernel
+static void BM_EvaluateScalar(benchmark::State& state) {
+    Position pos = loadCase(state);
+    bool simd = Evaluate::simdEnabled();
+    Evaluate::setSimdEnabled(false);
+    for (auto _ : state) benchmark::DoNotOptimize(Evaluate::evaluate(pos));
+    Evaluate::setSimdEnabled(simd);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Material/PST summed from scratch over every piece, the cost the incremental score avoids
+static void BM_PsqScan(benchmark::State& state) {
+    Position pos = loadCase(state);
+    for (auto _ : state) benchmark::DoNotOptimize(pos.computePsqScore());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_GenerateLegal)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_MakeUnmake)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_LegalityCheck)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_ComputeStatus)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_Evaluate)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_EvaluateScalar)->DenseRange(0, SUITE_SIZE - 1);
+BENCHMARK(BM_PsqScan)->DenseRange(0, SUITE_SIZE - 1);
+
+int main(int argc, char** argv) {
+    // JSON by default so results can be diffed and plotted; an explicit format flag wins
+    std::vector<char*> args(argv, argv + argc);
+    bool hasFormat = false;
+    for (int i = 1; i < argc; ++i) if (std::strncmp(argv[i], "--benchmark_format", 18) == 0) hasFormat = true;
+    static char jsonFormat[] = "--benchmark_format=json";
+    if (!hasFormat) args.push_back(jsonFormat);
+    int count = (int)args.size();
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 2;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
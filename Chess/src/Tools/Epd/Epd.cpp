@@ -0,0 +1,134 @@
+// chess_epd: batch validation and classification of FEN/EPD positions
+//
+// Usage: chess_epd --epd <file> [--threads N] [--out <file>]
+// Every line (EPD, or a plain FEN) is parsed, checked with GameLogic::isLegalPosition and
+// classified by legal move count, check, checkmate and stalemate on a worker pool. A
+// summary with positions/second is printed; --out writes each position back as EPD with
+// its original operations plus "legal N;" and "status <normal|check|checkmate|stalemate|invalid>;"
+// (invalid lines also get the reason as a "c1" comment; unparseable ones are kept as read).
+
+#include "Feature/basic/GameLogic/GameLogic.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+enum class EpdStatus : uint8_t { INVALID, NORMAL, CHECK, CHECKMATE, STALEMATE };
+
+static const char* STATUS_NAMES[] = { "invalid", "normal", "check", "checkmate", "stalemate" };
+
+struct EpdResult {
+    EpdStatus status = EpdStatus::INVALID;
+    int legalMoves = 0;
+    std::string error; // parse or validation failure, empty otherwise
+    std::string epd;   // classified line for --out
+};
+
+// Positions per task: large enough to amortize the queue, small enough to balance the tail
+static const size_t CHUNK = 512;
+
+static void classify(const std::string& line, bool keepEpd, EpdResult& r) {
+    Position pos;
+    EpdOps ops;
+    bool parsed = Notation::setFromEPD(pos, line, &ops);
+    if (!parsed && Notation::setFromFEN(pos, line)) {
+        // Plain FEN line (its counters make it invalid EPD); keep them as EPD operations
+        parsed = true;
+        ops = { { "hmvc", std::to_string(pos.halfmoveClock()) }, { "fmvn", std::to_string(pos.fullmoveNumber()) } };
+    }
+    if (!parsed) {
+        ops.clear();
+        r.error = "malformed FEN/EPD";
+    } else if (GameLogic::isLegalPosition(pos, &r.error)) {
+        MoveList moves;
+        MoveGen::generateLegal(pos, moves);
+        bool check = pos.inCheck(pos.whiteToMove());
+        r.legalMoves = moves.size();
+        r.status = !moves.empty() ? (check ? EpdStatus::CHECK : EpdStatus::NORMAL)
+                                  : (check ? EpdStatus::CHECKMATE : EpdStatus::STALEMATE);
+    }
+    if (!keepEpd) return;
+    EpdOps added = { { "legal", std::to_string(r.legalMoves) }, { "status", STATUS_NAMES[(int)r.status] } };
+    if (r.status == EpdStatus::INVALID) added.emplace_back("c1", "\"" + r.error + "\"");
+    if (parsed) {
+        ops.insert(ops.end(), added.begin(), added.end());
+        r.epd = Notation::toEPD(pos, ops);
+    } else {
+        // Nothing to re-encode: the line as read, with the same operations appended
+        r.epd = line.substr(0, line.find_last_not_of(" \t") + 1);
+        for (const auto& op : added) r.epd += " " + op.first + " " + op.second + ";";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path, outPath;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--epd" && i + 1 < argc) path = argv[++i];
+        else if (a == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else { path.clear(); break; }
+    }
+    if (path.empty()) {
+        std::cout << "Usage: chess_epd --epd <file> [--threads N] [--out <file>]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in(path);
+    if (!in) { std::cerr << "cannot open " << path << std::endl; return 1; }
+    std::vector<std::string> lines;
+    std::vector<int> lineNumbers;
+    std::string line;
+    for (int n = 1; std::getline(in, line); ++n) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue; // blank or comment
+        if (line.back() == '\r') line.pop_back();
+        lines.push_back(line.substr(first));
+        lineNumbers.push_back(n);
+    }
+
+    ThreadPool pool(threads);
+    std::vector<EpdResult> results(lines.size());
+    bool keepEpd = !outPath.empty();
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t begin = 0; begin < lines.size(); begin += CHUNK) {
+        size_t end = std::min(begin + CHUNK, lines.size());
+        pool.enqueue([&, begin, end] {
+            for (size_t i = begin; i < end; ++i) classify(lines[i], keepEpd, results[i]);
+        });
+    }
+    pool.wait();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    uint64_t counts[5] = { 0, 0, 0, 0, 0 }, totalMoves = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const EpdResult& r = results[i];
+        ++counts[(int)r.status];
+        totalMoves += r.legalMoves;
+        if (r.status == EpdStatus::INVALID)
+            std::cerr << path << ":" << lineNumbers[i] << ": " << r.error << std::endl;
+    }
+    if (keepEpd) {
+        std::ofstream out(outPath);
+        for (const EpdResult& r : results) out << r.epd << '\n';
+        if (!out) { std::cerr << "cannot write " << outPath << std::endl; return 1; }
+    }
+
+    size_t valid = results.size() - counts[(int)EpdStatus::INVALID];
+    double pps = secs > 0.0 ? results.size() / secs : 0.0;
+    std::cout << results.size() << " positions (" << valid << " valid, " << counts[(int)EpdStatus::INVALID] << " invalid) in "
+              << secs << " s on " << pool.size() << " thread(s): " << (uint64_t)pps << " positions/s" << std::endl;
+    std::cout << "  check " << counts[(int)EpdStatus::CHECK] << ", checkmate " << counts[(int)EpdStatus::CHECKMATE]
+              << ", stalemate " << counts[(int)EpdStatus::STALEMATE] << ", legal moves " << totalMoves
+              << " (avg " << (valid ? (double)totalMoves / valid : 0.0) << ")" << std::endl;
+    return counts[(int)EpdStatus::INVALID] ? 1 : 0;
+}
@@ -0,0 +1,257 @@
+// chess_gamedb: binary game archives (import and decoding throughput)
+//
+// Usage: chess_gamedb --db <file> [--import <pgn>] [--encoding index8|raw16] [--threads N] [--window MB]
+//        chess_gamedb --check
+// --import appends every valid game of a PGN file to the archive (created if missing),
+// reading the PGN one memory-mapped window at a time like chess_pgn; games that do not
+// replay are skipped and counted. The archive is then mapped and every game decoded on a
+// worker pool, each move checked against the legal move generator, and games/minute,
+// bytes per ply and the result counts are reported. Exit code is non-zero on a corrupt record.
+// --check writes random games to a scratch archive, tears its last record, appends more and
+// verifies that exactly the complete games read back, in both encodings.
+
+#include "Feature/basic/GameLogic/GameArchive.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "Feature/basic/GameLogic/Pgn.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+// Games per decoding task
+static const size_t BATCH = 1024;
+
+static GameInfo infoFromTags(const PgnGame& game) {
+    GameInfo info;
+    if (game.result == "1-0") info.result = GameResult::WHITE_WINS;
+    else if (game.result == "0-1") info.result = GameResult::BLACK_WINS;
+    else if (game.result == "1/2-1/2") info.result = GameResult::DRAW;
+    auto elo = [](const std::string& s) { return (uint16_t)std::min(std::max(std::atoi(s.c_str()), 0), 65535); };
+    info.whiteElo = elo(game.tag("WhiteElo"));
+    info.blackElo = elo(game.tag("BlackElo"));
+    // "yyyy.mm.dd", unknown parts as "??"
+    std::string date = game.tag("Date");
+    if (date.size() == 10) {
+        auto part = [&](size_t at, size_t n) { return (uint32_t)std::atoi(date.substr(at, n).c_str()); };
+        info.date = part(0, 4) * 10000 + part(5, 2) * 100 + part(8, 2);
+    }
+    info.round = (uint32_t)std::max(std::atoi(game.tag("Round").c_str()), 0);
+    return info;
+}
+
+// Append the valid games of 'pgnPath'; returns false if a file cannot be opened
+static bool importPgn(const std::string& pgnPath, const std::string& dbPath, MoveEncoding encoding, size_t windowMB) {
+    MappedFile file;
+    if (!file.open(pgnPath)) { std::cerr << "cannot open " << pgnPath << std::endl; return false; }
+    GameArchiveWriter writer;
+    std::string error;
+    if (!writer.open(dbPath, error)) { std::cerr << error << std::endl; return false; }
+
+    const size_t baseWindow = windowMB << 20;
+    size_t window = baseWindow;
+    uint64_t offset = 0, skipped = 0;
+    Position pos, start;
+    PgnGame game;
+    std::vector<Move> moves;
+    auto t0 = std::chrono::steady_clock::now();
+    while (offset < file.size()) {
+        if (!file.map(offset, window)) { std::cerr << "cannot map " << pgnPath << " at byte " << offset << std::endl; return false; }
+        const char* text = file.data();
+        size_t len = file.length(), consumed = 0;
+        bool atEnd = offset + len == file.size(), any = false;
+        for (;;) {
+            size_t b, e;
+            if (!Pgn::nextGame(text + consumed, len - consumed, atEnd, b, e)) { consumed += b; break; }
+            any = true;
+            bool ok = Pgn::replay(text + consumed + b, e - b, pos, game, &moves);
+            consumed += e;
+            std::string fen = game.tag("FEN");
+            if (!ok || !Notation::setFromFEN(start, fen.empty() ? Notation::START_FEN : fen)
+                || !writer.append(start, moves, infoFromTags(game), encoding))
+                ++skipped;
+        }
+        if (!any && consumed < len) {
+            window *= 2; // a single game longer than the window
+            continue;
+        }
+        window = baseWindow;
+        offset += consumed;
+    }
+    writer.close();
+    if (writer.bytesDropped())
+        std::cout << "Cut " << writer.bytesDropped() << " bytes of an incomplete last record off " << dbPath << std::endl;
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "Imported " << writer.gamesWritten() << " games (" << skipped << " skipped) from " << pgnPath << " in "
+              << secs << " s" << std::endl;
+    return true;
+}
+
+// Seeded random playout of up to 'maxPlies' moves from 'fen'
+static std::vector<Move> randomGame(const std::string& fen, int maxPlies, std::mt19937& rng) {
+    Position pos;
+    Notation::setFromFEN(pos, fen);
+    std::vector<Move> moves;
+    MoveList legal;
+    for (int ply = 0; ply < maxPlies; ++ply) {
+        legal.clear();
+        MoveGen::generateLegal(pos, legal);
+        if (legal.size() == 0) break;
+        Move m = legal[(int)(rng() % (unsigned)legal.size())];
+        moves.push_back(m);
+        pos.makeMove(m);
+    }
+    return moves;
+}
+
+// Truncate-then-append round trip on a scratch archive; false (with a message) on a mismatch
+static bool checkArchive(MoveEncoding encoding) {
+    const std::string path = "chess_gamedb_check.tmp";
+    const char* name = encoding == MoveEncoding::RAW16 ? "raw16" : "index8";
+    const std::string fens[2] = { Notation::START_FEN,
+                                  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1" };
+    std::mt19937 rng(12345);
+    struct Game { Position start; std::vector<Move> moves; GameInfo info; };
+    std::vector<Game> games(6);
+    for (size_t i = 0; i < games.size(); ++i) {
+        Notation::setFromFEN(games[i].start, fens[i % 2]);
+        games[i].moves = randomGame(fens[i % 2], 40 + 20 * (int)i, rng);
+        games[i].info.result = (GameResult)(i % 4);
+        games[i].info.round = (uint32_t)i + 1;
+    }
+    auto fail = [&](const std::string& why) {
+        std::remove(path.c_str());
+        std::cerr << "Archive check (" << name << ") failed: " << why << std::endl;
+        return false;
+    };
+
+    // Games 0-3, then tear 5 bytes off game 3 as an interrupted append would
+    std::remove(path.c_str());
+    GameArchiveWriter writer;
+    std::string error;
+    if (!writer.open(path, error)) return fail(error);
+    for (int i = 0; i < 4; ++i)
+        if (!writer.append(games[i].start, games[i].moves, games[i].info, encoding)) return fail("append rejected");
+    writer.close();
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), (std::streamsize)bytes.size() - 5);
+
+    // Games 4-5 must land where game 3 began
+    if (!writer.open(path, error)) return fail(error);
+    if (writer.bytesDropped() == 0) return fail("the torn record was not cut off");
+    for (int i = 4; i < 6; ++i)
+        if (!writer.append(games[i].start, games[i].moves, games[i].info, encoding)) return fail("append rejected");
+    writer.close();
+
+    GameArchive archive;
+    if (!archive.open(path, error)) return fail(error);
+    const int expected[5] = { 0, 1, 2, 4, 5 };
+    if (archive.size() != 5) return fail(std::to_string(archive.size()) + " games read back, expected 5");
+    ArchivedGame game;
+    for (size_t i = 0; i < archive.size(); ++i) {
+        const Game& want = games[expected[i]];
+        if (!archive.read(i, game)) return fail("game " + std::to_string(i + 1) + " is corrupt");
+        if (game.moves.size() != want.moves.size() || !std::equal(game.moves.begin(), game.moves.end(), want.moves.begin())
+            || Notation::toFEN(game.start) != Notation::toFEN(want.start) || game.info.result != want.info.result
+            || game.info.round != want.info.round)
+            return fail("game " + std::to_string(i + 1) + " does not match what was written");
+    }
+    archive.close();
+    std::remove(path.c_str());
+    std::cout << "Archive check (" << name << ") passed" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string dbPath, pgnPath;
+    MoveEncoding encoding = MoveEncoding::INDEX8;
+    unsigned threads = 0;
+    size_t windowMB = 64;
+    bool usage = false, check = false;
+    for (int i = 1; i < argc && !usage; ++i) {
+        std::string a = argv[i];
+        if (a == "--db" && i + 1 < argc) dbPath = argv[++i];
+        else if (a == "--check") check = true;
+        else if (a == "--import" && i + 1 < argc) pgnPath = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--window" && i + 1 < argc) windowMB = (size_t)std::max(1, std::atoi(argv[++i]));
+        else if (a == "--encoding" && i + 1 < argc) {
+            std::string e = argv[++i];
+            if (e == "raw16") encoding = MoveEncoding::RAW16;
+            else if (e != "index8") usage = true;
+        }
+        else usage = true;
+    }
+    if (check) {
+        bool index8 = checkArchive(MoveEncoding::INDEX8);
+        bool raw16 = checkArchive(MoveEncoding::RAW16);
+        return index8 && raw16 ? 0 : 1;
+    }
+    if (usage || dbPath.empty()) {
+        std::cout << "Usage: chess_gamedb --db <file> [--import <pgn>] [--encoding index8|raw16] [--threads N] [--window MB]" << std::endl;
+        std::cout << "       chess_gamedb --check" << std::endl;
+        return 2;
+    }
+    if (!pgnPath.empty() && !importPgn(pgnPath, dbPath, encoding, windowMB)) return 1;
+
+    GameArchive archive;
+    std::string error;
+    if (!archive.open(dbPath, error)) { std::cerr << error << std::endl; return 1; }
+
+    ThreadPool pool(threads);
+    std::atomic<uint64_t> plies(0), corrupt(0);
+    std::atomic<uint64_t> results[4] = {};
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t first = 0; first < archive.size(); first += BATCH) {
+        size_t last = std::min(first + BATCH, archive.size());
+        pool.enqueue([&, first, last] {
+            ArchivedGame game;
+            uint64_t n = 0, bad = 0, counts[4] = { 0, 0, 0, 0 };
+            for (size_t i = first; i < last; ++i) {
+                if (!archive.read(i, game)) {
+                    ++bad;
+                    std::cerr << dbPath << ": game " << i + 1 << " is corrupt" << std::endl;
+                    continue;
+                }
+                n += game.moves.size();
+                ++counts[(int)game.info.result];
+            }
+            plies += n;
+            corrupt += bad;
+            for (int r = 0; r < 4; ++r) results[r] += counts[r];
+        });
+    }
+    pool.wait();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    size_t games = archive.size();
+    uint64_t bytes = 0;
+    {
+        MappedFile f;
+        if (f.open(dbPath)) bytes = f.size();
+    }
+    std::cout << games << " games, " << plies << " plies, " << bytes << " bytes ("
+              << (plies ? (double)bytes / plies : 0.0) << " bytes/ply incl. headers); "
+              << results[1] << " white wins, " << results[2] << " black wins, " << results[3] << " draws, "
+              << results[0] << " unknown" << std::endl;
+    std::cout << "Decoded and verified in " << secs << " s on " << pool.size() << " thread(s)";
+    if (secs > 0.0) std::cout << ": " << (uint64_t)(games / secs * 60.0) << " games/minute, " << (uint64_t)(plies / secs) << " plies/s";
+    std::cout << std::endl;
+    if (corrupt) std::cerr << corrupt << " corrupt game(s)" << std::endl;
+    return corrupt ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+// chess_nnue_bench: correctness and throughput of the NNUE vector kernels
+//
+// Usage: chess_nnue_bench [--net <file>] [--games N] [--seed N]
+// Without --net a deterministic random network is written to nnue_random.nnue and used,
+// so the kernels can be checked without a trained network. Random playouts from a fixed
+// suite are evaluated with every kernel the CPU supports, both from scratch and with
+// incrementally updated accumulators; every score must equal the scalar reference (the
+// exit code is non-zero otherwise). Evaluations/second and a checksum of all scores are
+// reported per kernel.
+
+#include "Feature/advanced/Nnue/Nnue.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static const char* SUITE[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r2q1rk1/ppp2ppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP2PPP/R2Q1RK1 w - - 0 8",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+};
+
+// One playout: a start position and the moves played from it
+struct Line {
+    Position start;
+    std::vector<Move> moves;
+};
+
+static bool writeRandomNetwork(const std::string& path, uint64_t seed) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    std::mt19937_64 rng(seed);
+    auto put = [&](uint64_t v, int bytes) { for (int i = 0; i < bytes; ++i) out.put((char)(v >> (8 * i))); };
+    auto uniform = [&](int lo, int hi) { return lo + (int)(rng() % (uint64_t)(hi - lo + 1)); };
+    out.write(Nnue::MAGIC, 8);
+    put(Nnue::INPUTS, 4); put(Nnue::HALF, 4); put(Nnue::L2, 4); put(Nnue::L3, 4); put(1, 4);
+    for (size_t i = 28; i < Nnue::HEADER_SIZE; ++i) out.put(0);
+    for (int i = 0; i < Nnue::HALF; ++i) put((uint16_t)uniform(0, 64), 2);
+    for (size_t i = 0; i < (size_t)Nnue::INPUTS * Nnue::HALF; ++i) put((uint16_t)uniform(-24, 24), 2);
+    auto layer = [&](int outputs, int inputs) {
+        for (int i = 0; i < outputs; ++i) put((uint32_t)uniform(-2000, 2000), 4);
+        for (int i = 0; i < outputs * inputs; ++i) put((uint8_t)uniform(-127, 127), 1);
+    };
+    layer(Nnue::L2, 2 * Nnue::HALF);
+    layer(Nnue::L3, Nnue::L2);
+    layer(1, Nnue::L3);
+    return (bool)out;
+}
+
+// Plays every line with lazily updated accumulators (as the AI search does) and calls
+// f(score) for each position reached
+template <class F>
+static void playIncremental(const Nnue& net, const std::vector<Line>& lines, F f) {
+    std::vector<NnueAccumulator> acc(1);
+    NnueDelta d;
+    for (const Line& line : lines) {
+        Position pos = line.start;
+        acc.resize(1);
+        net.refresh(pos, acc[0], 0);
+        net.refresh(pos, acc[0], 1);
+        for (Move m : line.moves) {
+            Nnue::delta(pos, m, d);
+            pos.makeMove(m);
+            NnueAccumulator next;
+            for (int p = 0; p < 2; ++p) {
+                if (d.kingMoved[p]) net.refresh(pos, next, p);
+                else net.update(acc.back(), d, pos, next, p);
+            }
+            acc.push_back(next);
+            f(net.evaluate(pos, acc.back()));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string netPath;
+    int games = 200;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--net" && i + 1 < argc) netPath = argv[++i];
+        else if (a == "--games" && i + 1 < argc) games = std::atoi(argv[++i]);
+        else if (a == "--seed" && i + 1 < argc) seed = (uint64_t)std::atoll(argv[++i]);
+        else {
+            std::cout << "Usage: chess_nnue_bench [--net <file>] [--games N] [--seed N]" << std::endl;
+            return 2;
+        }
+    }
+    if (netPath.empty()) {
+        netPath = "nnue_random.nnue";
+        if (!writeRandomNetwork(netPath, seed)) {
+            std::cerr << "cannot write " << netPath << std::endl;
+            return 1;
+        }
+    }
+    Nnue net;
+    std::string error;
+    if (!net.load(netPath, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // Random playouts of up to 100 plies from each suite position
+    std::mt19937 rng((unsigned)seed);
+    std::vector<Line> lines;
+    std::vector<Position> positions;
+    for (int g = 0; g < games; ++g) {
+        Line line;
+        Notation::setFromFEN(line.start, SUITE[g % (sizeof(SUITE) / sizeof(SUITE[0]))]);
+        Position pos = line.start;
+        for (int ply = 0; ply < 100; ++ply) {
+            MoveList moves;
+            MoveGen::generateLegal(pos, moves);
+            if (moves.empty()) break;
+            Move m = moves[rng() % moves.size()];
+            line.moves.push_back(m);
+            pos.makeMove(m);
+            positions.push_back(pos);
+        }
+        lines.push_back(line);
+    }
+
+    // Scalar reference scores
+    Nnue::Kernel best = Nnue::bestKernel();
+    Nnue::setKernel(Nnue::Kernel::SCALAR);
+    std::vector<int> reference;
+    for (const Position& pos : positions) reference.push_back(net.evaluate(pos));
+
+    std::cout << "NNUE bench: " << positions.size() << " positions from " << lines.size() << " playouts, best kernel "
+              << Nnue::kernelName(best) << std::endl;
+    std::cout << std::setw(8) << "kernel" << std::setw(16) << "refresh eval/s" << std::setw(16) << "incr eval/s"
+              << std::setw(10) << "speedup" << std::setw(12) << "mismatches" << std::setw(14) << "checksum" << std::endl;
+    bool ok = true;
+    double scalarRate = 0.0;
+    for (int k = 0; k <= (int)best; ++k) {
+        Nnue::setKernel((Nnue::Kernel)k);
+        size_t mismatches = 0, i = 0;
+        int64_t sink = 0; // sum of every score, printed so the timed loops cannot be dropped; equal across kernels
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t j = 0; j < positions.size(); ++j) {
+            int s = net.evaluate(positions[j]);
+            sink += s;
+            if (s != reference[j]) ++mismatches;
+        }
+        double refreshSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        t0 = std::chrono::steady_clock::now();
+        playIncremental(net, lines, [&](int s) {
+            sink += s;
+            if (s != reference[i++]) ++mismatches;
+        });
+        double incrSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        double rate = positions.size() / incrSecs;
+        if (k == 0) scalarRate = rate;
+        std::cout << std::setw(8) << Nnue::kernelName((Nnue::Kernel)k) << std::setw(16) << (uint64_t)(positions.size() / refreshSecs)
+                  << std::setw(16) << (uint64_t)rate << std::setw(9) << std::fixed << std::setprecision(2) << rate / scalarRate << "x"
+                  << std::setw(12) << mismatches << std::setw(14) << sink << std::endl;
+        if (mismatches) ok = false;
+    }
+    Nnue::setKernel(best);
+    std::cout << (ok ? "all kernels match the scalar reference" : "KERNEL MISMATCH") << std::endl;
+    return ok ? 0 : 1;
+}
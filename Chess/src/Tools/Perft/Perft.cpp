@@ -0,0 +1,150 @@
+// chess_perft: move-generation throughput and correctness gate for GameLogic
+//
+// Usage: chess_perft [--depth N] [--fen "<fen>"] [--divide] [--threads N] [--no-pext]
+// Without --fen the standard suite runs and every node count is checked
+// against the published reference values (non-zero exit code on mismatch).
+
+#include "Feature/basic/GameLogic/Attacks.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct PerftCase {
+    const char* name;
+    const char* fen;
+    int defaultDepth;
+    uint64_t expected[7]; // nodes at depth 1..7 (0 = unknown)
+};
+
+static const PerftCase SUITE[] = {
+    { "startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5,
+      { 20, 400, 8902, 197281, 4865609, 119060324, 3195901860ULL } },
+    { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4,
+      { 48, 2039, 97862, 4085603, 193690690, 8031647685ULL, 0 } },
+    { "endgame-ep", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5,
+      { 14, 191, 2812, 43238, 674624, 11030083, 178633661 } },
+    { "promotions", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4,
+      { 6, 264, 9467, 422333, 15833292, 706045033, 0 } },
+    { "talkchess", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4,
+      { 44, 1486, 62379, 2103487, 89941194, 0, 0 } },
+};
+
+// Per-thread move buffers, one per ply, reused so the hot path never allocates
+struct MoveStack {
+    std::vector<MoveList> plies;
+    explicit MoveStack(int depth) : plies(depth + 1) {}
+};
+
+static uint64_t perft(Position& pos, int depth, MoveStack& stack) {
+    MoveList& moves = stack.plies[depth];
+    moves.clear();
+    MoveGen::generateLegal(pos, moves);
+    if (depth <= 1) return moves.size(); // bulk count at the frontier
+    uint64_t nodes = 0;
+    for (int i = 0; i < moves.size(); ++i) {
+        pos.makeMove(moves[i]);
+        nodes += perft(pos, depth - 1, stack);
+        pos.unmakeMove();
+    }
+    return nodes;
+}
+
+struct DivideEntry {
+    Move move;
+    uint64_t nodes;
+};
+
+// Split the root moves across the pool; each task works on its own Position copy
+static uint64_t perftParallel(const Position& root, int depth, ThreadPool& pool, std::vector<DivideEntry>& divide) {
+    MoveList rootMoves;
+    MoveGen::generateLegal(root, rootMoves);
+    divide.assign(rootMoves.size(), DivideEntry());
+    if (depth <= 1) {
+        for (int i = 0; i < rootMoves.size(); ++i) divide[i] = DivideEntry{ rootMoves[i], 1 };
+        return rootMoves.size();
+    }
+    for (int i = 0; i < rootMoves.size(); ++i) {
+        pool.enqueue([&, i]{
+            Position pos = root;
+            MoveStack stack(depth);
+            pos.makeMove(rootMoves[i]);
+            divide[i] = DivideEntry{ rootMoves[i], perft(pos, depth - 1, stack) };
+        });
+    }
+    pool.wait();
+    uint64_t total = 0;
+    for (const auto& d : divide) total += d.nodes;
+    return total;
+}
+
+static bool runCase(const std::string& name, const std::string& fen, int depth, uint64_t expected, bool showDivide, ThreadPool& pool) {
+    Position pos;
+    if (!Notation::setFromFEN(pos, fen)) {
+        std::cout << name << ": invalid FEN: " << fen << std::endl;
+        return false;
+    }
+    std::vector<DivideEntry> divide;
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t nodes = perftParallel(pos, depth, pool, divide);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (showDivide) {
+        std::sort(divide.begin(), divide.end(), [](const DivideEntry& a, const DivideEntry& b) {
+            return Notation::moveToString(a.move) < Notation::moveToString(b.move);
+        });
+        for (const auto& d : divide) std::cout << "  " << Notation::moveToString(d.move) << ": " << d.nodes << std::endl;
+    }
+    bool ok = expected == 0 || nodes == expected;
+    double nps = secs > 0.0 ? nodes / secs : 0.0;
+    std::cout << name << " depth " << depth << ": " << nodes << " nodes in " << secs << " s ("
+              << (uint64_t)nps << " nps)";
+    if (expected) std::cout << (ok ? "  OK" : "  MISMATCH, expected ") << (ok ? "" : std::to_string(expected));
+    std::cout << std::endl;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int depth = 0;
+    unsigned threads = 0;
+    bool showDivide = false;
+    std::string fen;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--depth" && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else if (a == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--divide") showDivide = true;
+        else if (a == "--no-pext") Attacks::setPextEnabled(false);
+        else {
+            std::cout << "Usage: chess_perft [--depth N] [--fen \"<fen>\"] [--divide] [--threads N] [--no-pext]" << std::endl;
+            return 2;
+        }
+    }
+
+    ThreadPool pool(threads);
+    std::cout << "perft using " << pool.size() << " thread(s), "
+              << (Attacks::pextEnabled() ? "PEXT" : "magic") << " slider lookup" << std::endl;
+
+    if (!fen.empty()) {
+        runCase("custom", fen, depth > 0 ? depth : 4, 0, showDivide, pool);
+        return 0;
+    }
+
+    bool allOk = true;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const PerftCase& c : SUITE) {
+        int d = depth > 0 ? std::min(depth, 7) : c.defaultDepth;
+        allOk &= runCase(c.name, c.fen, d, c.expected[d - 1], showDivide, pool);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << (allOk ? "All perft results match" : "PERFT MISMATCH") << " (" << secs << " s total)" << std::endl;
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// chess_pgn: parallel replay and validation of PGN collections
+//
+// Usage: chess_pgn --pgn <file> [--threads N] [--window MB] [--out <file>]
+// The file is memory-mapped one window at a time (default 64 MB) and split at game
+// boundaries; the games of each window are replayed on a worker pool, every SAN move
+// resolved through the legal move generator. Illegal moves are reported with the game
+// number, byte offset and position; --out writes each game's final position as EPD.
+// Memory use is bounded by the window size, not the file size.
+
+#include "Feature/basic/GameLogic/Notation.h"
+#include "Feature/basic/GameLogic/Pgn.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct GameSpan {
+    size_t begin, length; // within the current window
+};
+
+struct GameReport {
+    PgnGame game;
+    std::string where; // FEN where replay stopped (failed games only)
+    std::string epd;   // final position for --out
+};
+
+// Games per task
+static const size_t BATCH = 64;
+
+int main(int argc, char** argv) {
+    std::string path, outPath;
+    unsigned threads = 0;
+    size_t windowMB = 64;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--pgn" && i + 1 < argc) path = argv[++i];
+        else if (a == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--window" && i + 1 < argc) windowMB = (size_t)std::max(1, std::atoi(argv[++i]));
+        else { path.clear(); break; }
+    }
+    if (path.empty()) {
+        std::cout << "Usage: chess_pgn --pgn <file> [--threads N] [--window MB] [--out <file>]" << std::endl;
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) { std::cerr << "cannot open " << path << std::endl; return 1; }
+    std::ofstream out;
+    if (!outPath.empty()) {
+        out.open(outPath);
+        if (!out) { std::cerr << "cannot write " << outPath << std::endl; return 1; }
+    }
+    bool keepEpd = out.is_open();
+
+    ThreadPool pool(threads);
+    const size_t baseWindow = windowMB << 20;
+    size_t window = baseWindow;
+    uint64_t offset = 0, games = 0, failed = 0, plies = 0;
+    std::vector<GameSpan> spans;
+    std::vector<GameReport> reports;
+    auto t0 = std::chrono::steady_clock::now();
+
+    while (offset < file.size()) {
+        if (!file.map(offset, window)) { std::cerr << "cannot map " << path << " at byte " << offset << std::endl; return 1; }
+        const char* text = file.data();
+        size_t len = file.length();
+        bool atEnd = offset + len == file.size();
+
+        // Complete games of this window; an unfinished last game starts the next window
+        spans.clear();
+        size_t consumed = 0;
+        for (;;) {
+            size_t b, e;
+            if (!Pgn::nextGame(text + consumed, len - consumed, atEnd, b, e)) { consumed += b; break; }
+            spans.push_back({ consumed + b, e - b });
+            consumed += e;
+        }
+        if (spans.empty() && consumed < len) {
+            window *= 2; // a single game longer than the window
+            continue;
+        }
+        window = baseWindow;
+
+        reports.clear();
+        reports.resize(spans.size());
+        uint64_t firstGame = games + 1;
+        for (size_t first = 0; first < spans.size(); first += BATCH) {
+            size_t last = std::min(first + BATCH, spans.size());
+            pool.enqueue([&, first, last] {
+                Position pos;
+                for (size_t i = first; i < last; ++i) {
+                    GameReport& r = reports[i];
+                    bool ok = Pgn::replay(text + spans[i].begin, spans[i].length, pos, r.game);
+                    if (!ok) r.where = Notation::toFEN(pos);
+                    if (keepEpd) {
+                        EpdOps ops = { { "id", "\"" + std::to_string(firstGame + i) + "\"" },
+                                       { "hmvc", std::to_string(pos.halfmoveClock()) },
+                                       { "fmvn", std::to_string(pos.fullmoveNumber()) } };
+                        if (!r.game.result.empty()) ops.emplace_back("c0", "\"" + r.game.result + "\"");
+                        if (!ok) ops.emplace_back("c1", "\"" + r.game.error + "\"");
+                        r.epd = Notation::toEPD(pos, ops);
+                    }
+                }
+            });
+        }
+        pool.wait();
+
+        for (size_t i = 0; i < reports.size(); ++i) {
+            const GameReport& r = reports[i];
+            ++games;
+            plies += r.game.plies;
+            if (!r.game.ok) {
+                ++failed;
+                std::cerr << path << ": game " << games << " (byte " << offset + spans[i].begin << "): " << r.game.error;
+                if (!r.game.badMove.empty()) std::cerr << " '" << r.game.badMove << "' at ply " << r.game.plies + 1;
+                std::cerr << " in " << r.where << std::endl;
+            }
+            if (keepEpd) out << r.epd << '\n';
+        }
+        offset += consumed;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    double mb = file.size() / (1024.0 * 1024.0);
+    std::cout << games << " games (" << games - failed << " valid, " << failed << " invalid), " << plies << " plies in "
+              << secs << " s on " << pool.size() << " thread(s)" << std::endl;
+    if (secs > 0.0)
+        std::cout << "  " << (uint64_t)(games / secs) << " games/s, " << (uint64_t)(plies / secs) << " plies/s, "
+                  << mb / secs << " MB/s" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+// chess_selfplay: concurrent self-play matches between two AI configurations
+//
+// Usage: chess_selfplay [--games N] [--concurrency N] [--tc <base>+<inc>] [--hash MB]
+//                       [--openings <epd>] [--random-plies N] [--opening-window CP] [--seed N]
+//                       [--tb <dir>] [--nnue-a <file>] [--nnue-b <file>] [--resign CP] [--draw-after N]
+//                       [--max-plies N] [--pgn <file>]
+// Player A and player B are the same engine unless one of them gets a network. Games are
+// played in pairs from the same opening with colors swapped: a start position (the next
+// line of --openings, or the initial position) followed by --random-plies random legal
+// moves drawn from --seed, redrawn while a depth-4 search scores the result beyond
+// --opening-window centipawns (default 100, 0 disables). Each game runs on one pool thread
+// with its own Position and one single-threaded engine per side; only the read-only tables
+// and networks are shared.
+// Clocks: --tc gives the base time and Fischer increment in seconds (default 10+0.1); a side
+// whose clock runs out loses. Adjudication ends decided games early: a tablebase position
+// (--tb), both sides agreeing on a score beyond --resign centipawns for 3 moves each (default
+// 800, 0 disables), or |score| <= 10 for 8 plies once --draw-after plies are played (default
+// 80, 0 disables); --max-plies (default 400) draws anything longer.
+// Prints A's result with an Elo estimate, terminations, games/hour and move timing
+// statistics; --pgn writes every game.
+
+#include "Feature/advanced/AI/AI.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct MatchConfig {
+    int games = 100;
+    unsigned concurrency = 0;
+    int baseMs = 10000, incMs = 100;
+    int hashMb = 8;
+    int randomPlies = 8;
+    int openingWindow = 100;   // centipawns; random openings scored beyond it are redrawn
+    uint64_t seed = 1;
+    int resignCp = 800;
+    int drawAfter = 80;
+    int maxPlies = 400;
+    const Tablebase* tablebase = nullptr;
+    const Nnue* nnue[2] = { nullptr, nullptr };   // per player, A then B
+};
+
+enum class Termination { CHECKMATE, STALEMATE, REPETITION, FIFTY_MOVES, MATERIAL, TABLEBASE, RESIGN, DRAW_ADJUDICATION,
+                         MAX_PLIES, TIME_FORFEIT, COUNT };
+
+static const char* TERMINATION_NAMES[] = { "checkmate", "stalemate", "threefold repetition", "fifty-move rule",
+                                           "insufficient material", "tablebase", "resign adjudication",
+                                           "draw adjudication", "max plies", "time forfeit" };
+
+struct GameRecord {
+    int round = 0;
+    bool aIsWhite = true;
+    Position start;
+    std::vector<Move> moves;
+    int result = 0;            // +1 White wins, 0 draw, -1 Black wins
+    Termination termination = Termination::MAX_PLIES;
+    std::vector<double> moveMs;      // time each move took
+    std::vector<double> overshootMs; // time taken beyond the allotment
+};
+
+// Draw by material: no pawns or majors, and at most one minor piece on the board
+static bool insufficientMaterial(const Position& pos) {
+    if (pos.pieces(PieceType::PAWN) | pos.pieces(PieceType::ROOK) | pos.pieces(PieceType::QUEEN)) return false;
+    return popCount(pos.pieces(PieceType::KNIGHT) | pos.pieces(PieceType::BISHOP)) <= 1;
+}
+
+// Same position (side to move included) for the third time since the last irreversible move
+static bool threefold(const std::vector<uint64_t>& keys, int halfmoveClock) {
+    int last = (int)keys.size() - 1, seen = 1;
+    for (int i = last - 2; i >= 0 && i >= last - halfmoveClock; i -= 2)
+        if (keys[i] == keys[last] && ++seen == 3) return true;
+    return false;
+}
+
+static void playGame(const MatchConfig& config, GameRecord& game) {
+    // One engine per side and pool thread, reused across games; nothing is shared but the
+    // read-only tables and networks
+    thread_local std::unique_ptr<AI> engines[2];
+    for (int p = 0; p < 2; ++p) {
+        if (!engines[p]) engines[p].reset(new AI((size_t)config.hashMb, 1));
+        engines[p]->clearHash();
+        engines[p]->setTablebase(config.tablebase);
+        engines[p]->setNnue(config.nnue[p]);
+    }
+
+    Position pos = game.start;
+    std::vector<uint64_t> keys(1, pos.key());
+    double clock[2] = { (double)config.baseMs, (double)config.baseMs }; // White, Black
+    int lastScore[2][3] = { { 0 } };  // recent scores of each color, from its own side
+    int scored[2] = { 0, 0 };
+    int quietPlies = 0;               // consecutive plies with |score| <= 10
+    for (;;) {
+        int side = pos.whiteToMove() ? 0 : 1;
+        int winner = side == 0 ? -1 : 1; // result if the side to move loses
+        MoveList legal;
+        MoveGen::generateLegal(pos, legal);
+        TbResult tb;
+        if (legal.empty()) {
+            bool mated = pos.inCheck(pos.whiteToMove());
+            game.result = mated ? winner : 0;
+            game.termination = mated ? Termination::CHECKMATE : Termination::STALEMATE;
+            return;
+        }
+        if (threefold(keys, pos.halfmoveClock())) { game.termination = Termination::REPETITION; return; }
+        if (pos.halfmoveClock() >= 100) { game.termination = Termination::FIFTY_MOVES; return; }
+        if (insufficientMaterial(pos)) { game.termination = Termination::MATERIAL; return; }
+        if (config.tablebase && config.tablebase->probe(pos, tb)) {
+            game.result = tb.wdl == TbWdl::DRAW ? 0 : tb.wdl == TbWdl::WIN ? -winner : winner;
+            game.termination = Termination::TABLEBASE;
+            return;
+        }
+        if ((int)game.moves.size() >= config.maxPlies) { game.termination = Termination::MAX_PLIES; return; }
+
+        AI& engine = *engines[(side == 0) == game.aIsWhite ? 0 : 1];
+        SearchLimits limits;
+        limits.timeMs = AI::allocateTime((int)clock[side], config.incMs);
+        auto t0 = std::chrono::steady_clock::now();
+        SearchResult r = engine.think(pos, limits);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        game.moveMs.push_back(ms);
+        game.overshootMs.push_back(ms - limits.timeMs);
+        clock[side] -= ms;
+        if (clock[side] < 0.0) {
+            game.result = winner;
+            game.termination = Termination::TIME_FORFEIT;
+            return;
+        }
+        clock[side] += config.incMs;
+
+        game.moves.push_back(r.bestMove);
+        pos.makeMove(r.bestMove);
+        keys.push_back(pos.key());
+
+        // Adjudication on the engines' own scores
+        int* recent = lastScore[side];
+        recent[0] = recent[1]; recent[1] = recent[2]; recent[2] = r.score;
+        ++scored[side];
+        quietPlies = std::abs(r.score) <= 10 ? quietPlies + 1 : 0;
+        if (config.resignCp > 0 && scored[0] >= 3 && scored[1] >= 3) {
+            int other = 1 - side;
+            bool lost = true, won = true;
+            for (int i = 0; i < 3; ++i) {
+                lost = lost && lastScore[side][i] <= -config.resignCp && lastScore[other][i] >= config.resignCp;
+                won = won && lastScore[side][i] >= config.resignCp && lastScore[other][i] <= -config.resignCp;
+            }
+            if (lost || won) {
+                // 'winner' was computed for the side that just moved
+                game.result = lost ? winner : -winner;
+                game.termination = Termination::RESIGN;
+                return;
+            }
+        }
+        if (config.drawAfter > 0 && (int)game.moves.size() >= config.drawAfter && quietPlies >= 8) {
+            game.termination = Termination::DRAW_ADJUDICATION;
+            return;
+        }
+    }
+}
+
+static std::string resultString(int result) {
+    return result > 0 ? "1-0" : result < 0 ? "0-1" : "1/2-1/2";
+}
+
+static void writePgn(std::ostream& out, const GameRecord& game, const MatchConfig& config) {
+    std::ostringstream tc;
+    tc << config.baseMs / 1000.0 << "+" << config.incMs / 1000.0;
+    out << "[Event \"chess_selfplay\"]\n[Round \"" << game.round << "\"]\n"
+        << "[White \"" << (game.aIsWhite ? "A" : "B") << "\"]\n[Black \"" << (game.aIsWhite ? "B" : "A") << "\"]\n"
+        << "[Result \"" << resultString(game.result) << "\"]\n[TimeControl \"" << tc.str() << "\"]\n"
+        << "[Termination \"" << TERMINATION_NAMES[(int)game.termination] << "\"]\n"
+        << "[SetUp \"1\"]\n[FEN \"" << Notation::toFEN(game.start) << "\"]\n\n";
+    Position pos = game.start;
+    std::string line;
+    for (size_t i = 0; i < game.moves.size(); ++i) {
+        std::string token;
+        if (pos.whiteToMove()) token = std::to_string(pos.fullmoveNumber()) + ". ";
+        else if (i == 0) token = std::to_string(pos.fullmoveNumber()) + "... ";
+        token += Notation::moveToSAN(pos, game.moves[i]);
+        pos.makeMove(game.moves[i]);
+        if (line.size() + token.size() + 1 > 79) { out << line << "\n"; line.clear(); }
+        line += (line.empty() ? "" : " ") + token;
+    }
+    if (line.size() + 8 > 79) { out << line << "\n"; line.clear(); }
+    out << line << (line.empty() ? "" : " ") << resultString(game.result) << "\n\n";
+}
+
+// Opening of one game pair: the start position plus seeded random legal moves. Random moves
+// can hand one side the game (even a mate in a few moves), so a draw is kept only if a depth
+// OPENING_DEPTH search scores it within 'window' centipawns (0 accepts any); after 100 draws
+// the most balanced one is used. Start positions without random plies are taken as given
+static const int OPENING_DEPTH = 4;
+
+static Position makeOpening(AI& judge, const std::string& fen, int randomPlies, int window, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    Position best;
+    int bestScore = AI::MATE + 1;
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        Position pos;
+        Notation::setFromFEN(pos, fen);
+        int ply = 0;
+        for (; ply < randomPlies; ++ply) {
+            MoveList moves;
+            MoveGen::generateLegal(pos, moves);
+            if (moves.empty()) break;
+            pos.makeMove(moves[rng() % moves.size()]);
+        }
+        MoveList replies;
+        MoveGen::generateLegal(pos, replies);
+        if (ply < randomPlies || replies.empty()) {
+            if (attempt == 0) best = pos; // fallback should every draw end the game
+            continue;
+        }
+        if (randomPlies == 0 || window <= 0) return pos;
+        judge.clearHash(); // the same opening must get the same verdict in every run
+        SearchLimits limits;
+        limits.maxDepth = OPENING_DEPTH;
+        int score = std::abs(judge.think(pos, limits).score);
+        if (score <= window) return pos;
+        if (score < bestScore) { best = pos; bestScore = score; }
+    }
+    return best;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    size_t k = std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static double eloFromScore(double s) {
+    s = std::min(std::max(s, 0.001), 0.999);
+    return -400.0 * std::log10(1.0 / s - 1.0);
+}
+
+int main(int argc, char** argv) {
+    MatchConfig config;
+    std::string openingsPath, pgnPath, tbDir, nnuePath[2];
+    bool usage = false;
+    for (int i = 1; i < argc && !usage; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--games" && hasValue) config.games = std::atoi(argv[++i]);
+        else if (a == "--concurrency" && hasValue) config.concurrency = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--tc" && hasValue) {
+            std::string tc = argv[++i];
+            size_t plus = tc.find('+');
+            config.baseMs = (int)(std::atof(tc.substr(0, plus).c_str()) * 1000.0);
+            config.incMs = plus == std::string::npos ? 0 : (int)(std::atof(tc.substr(plus + 1).c_str()) * 1000.0);
+        }
+        else if (a == "--hash" && hasValue) config.hashMb = std::atoi(argv[++i]);
+        else if (a == "--openings" && hasValue) openingsPath = argv[++i];
+        else if (a == "--random-plies" && hasValue) config.randomPlies = std::atoi(argv[++i]);
+        else if (a == "--opening-window" && hasValue) config.openingWindow = std::atoi(argv[++i]);
+        else if (a == "--seed" && hasValue) config.seed = (uint64_t)std::atoll(argv[++i]);
+        else if (a == "--tb" && hasValue) tbDir = argv[++i];
+        else if (a == "--nnue-a" && hasValue) nnuePath[0] = argv[++i];
+        else if (a == "--nnue-b" && hasValue) nnuePath[1] = argv[++i];
+        else if (a == "--resign" && hasValue) config.resignCp = std::atoi(argv[++i]);
+        else if (a == "--draw-after" && hasValue) config.drawAfter = std::atoi(argv[++i]);
+        else if (a == "--max-plies" && hasValue) config.maxPlies = std::atoi(argv[++i]);
+        else if (a == "--pgn" && hasValue) pgnPath = argv[++i];
+        else usage = true;
+    }
+    if (usage || config.games < 1 || config.baseMs <= 0 || config.hashMb < 1) {
+        std::cout << "Usage: chess_selfplay [--games N] [--concurrency N] [--tc <base>+<inc>] [--hash MB]\n"
+                     "                      [--openings <epd>] [--random-plies N] [--opening-window CP] [--seed N]\n"
+                     "                      [--tb <dir>] [--nnue-a <file>] [--nnue-b <file>] [--resign CP] [--draw-after N]\n"
+                     "                      [--max-plies N] [--pgn <file>]" << std::endl;
+        return 2;
+    }
+
+    std::vector<std::string> openings;
+    if (!openingsPath.empty()) {
+        std::ifstream in(openingsPath);
+        if (!in) { std::cerr << "cannot open " << openingsPath << std::endl; return 1; }
+        std::string line;
+        Position probe;
+        while (std::getline(in, line))
+            if (Notation::setFromEPD(probe, line) || Notation::setFromFEN(probe, line)) openings.push_back(Notation::toFEN(probe));
+        if (openings.empty()) { std::cerr << "no positions in " << openingsPath << std::endl; return 1; }
+    } else {
+        openings.push_back(Notation::START_FEN);
+    }
+
+    // Shared read-only state; declared before the pool so it outlives the engines
+    Tablebase tablebase;
+    if (!tbDir.empty()) {
+        std::cout << "Tablebases: " << tablebase.load(tbDir) << " loaded" << std::endl;
+        config.tablebase = &tablebase;
+    }
+    Nnue nnue[2];
+    for (int p = 0; p < 2; ++p) {
+        if (nnuePath[p].empty()) continue;
+        std::string error;
+        if (!nnue[p].load(nnuePath[p], error)) { std::cerr << error << std::endl; return 1; }
+        config.nnue[p] = &nnue[p];
+    }
+
+    std::vector<GameRecord> games((size_t)config.games);
+    AI judge(4, 1);
+    for (int g = 0; g < config.games; ++g) {
+        int pair = g / 2;
+        games[g].round = g + 1;
+        games[g].aIsWhite = g % 2 == 0;
+        games[g].start = g % 2 ? games[g - 1].start
+                               : makeOpening(judge, openings[pair % openings.size()], config.randomPlies, config.openingWindow,
+                                             config.seed * 1000003 + pair);
+    }
+
+    ThreadPool pool(config.concurrency);
+    std::cout << "Self-play: " << config.games << " games, " << pool.size() << " concurrent, tc "
+              << config.baseMs / 1000.0 << "+" << config.incMs / 1000.0 << " s, hash " << config.hashMb << " MB per engine, A "
+              << (config.nnue[0] ? "NNUE" : "classic") << " vs B " << (config.nnue[1] ? "NNUE" : "classic") << std::endl;
+
+    std::mutex progressMutex;
+    int done = 0, points2 = 0; // A's points, doubled
+    int progressStep = std::max(1, config.games / 10);
+    auto t0 = std::chrono::steady_clock::now();
+    for (GameRecord& game : games) {
+        pool.enqueue([&]() {
+            playGame(config, game);
+            std::lock_guard<std::mutex> lock(progressMutex);
+            points2 += 1 + (game.aIsWhite ? game.result : -game.result);
+            if (++done % progressStep == 0 || done == config.games)
+                std::cout << "  " << done << "/" << config.games << " games, A scores " << points2 / 2.0 << std::endl;
+        });
+    }
+    pool.wait();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    int wins = 0, draws = 0, losses = 0, termination[(int)Termination::COUNT] = { 0 };
+    size_t plies = 0;
+    std::vector<double> moveMs, overshootMs;
+    for (const GameRecord& game : games) {
+        int r = game.aIsWhite ? game.result : -game.result;
+        (r > 0 ? wins : r < 0 ? losses : draws)++;
+        ++termination[(int)game.termination];
+        plies += game.moves.size();
+        moveMs.insert(moveMs.end(), game.moveMs.begin(), game.moveMs.end());
+        overshootMs.insert(overshootMs.end(), game.overshootMs.begin(), game.overshootMs.end());
+    }
+
+    // Elo with a 95% interval from the per-game score variance
+    int n = config.games;
+    double score = (wins + 0.5 * draws) / n;
+    double variance = (wins * std::pow(1.0 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / n;
+    double margin = 1.96 * std::sqrt(variance / n);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "A vs B: +" << wins << " =" << draws << " -" << losses << "  score " << 100.0 * score << "%  Elo "
+              << eloFromScore(score) << " [" << eloFromScore(score - margin) << ", " << eloFromScore(score + margin) << "]" << std::endl;
+    std::cout << "Terminations:";
+    for (int t = 0; t < (int)Termination::COUNT; ++t)
+        if (termination[t]) std::cout << " " << TERMINATION_NAMES[t] << " " << termination[t] << ";";
+    std::cout << std::endl;
+    std::cout << "Throughput: " << secs << " s, " << n * 3600.0 / secs << " games/hour, " << (double)plies / n
+              << " plies/game" << std::endl;
+    double total = 0.0;
+    for (double ms : moveMs) total += ms;
+    std::cout << std::setprecision(2) << "Move time (ms): mean " << (moveMs.empty() ? 0.0 : total / moveMs.size())
+              << ", median " << percentile(moveMs, 0.5) << ", p95 " << percentile(moveMs, 0.95) << ", max "
+              << percentile(moveMs, 1.0) << std::endl;
+    std::cout << "Beyond allotment (ms): median " << percentile(overshootMs, 0.5) << ", p95 " << percentile(overshootMs, 0.95)
+              << ", max " << percentile(overshootMs, 1.0) << std::endl;
+
+    if (!pgnPath.empty()) {
+        std::ofstream out(pgnPath);
+        if (!out) { std::cerr << "cannot write " << pgnPath << std::endl; return 1; }
+        for (const GameRecord& game : games) writePgn(out, game, config);
+        std::cout << "Games written to " << pgnPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+// chess_smp_bench: Lazy SMP scaling of the AI search
+//
+// Usage: chess_smp_bench [--depth N] [--hash MB] [--max-threads N]
+// Every suite position is searched to a fixed depth with 1, 2, 4, 8 and 16
+// threads (capped by --max-threads). For each thread count it reports the total
+// time, nodes/second and the time-to-depth speedup over the single-thread run.
+
+#include "Feature/advanced/AI/AI.h"
+#include "Feature/basic/GameLogic/Notation.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+static const char* SUITE[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r2q1rk1/ppp2ppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP2PPP/R2Q1RK1 w - - 0 8",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+};
+
+int main(int argc, char** argv) {
+    int depth = 8, hashMb = 64, maxThreads = 16;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--depth" && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else if (a == "--hash" && i + 1 < argc) hashMb = std::atoi(argv[++i]);
+        else if (a == "--max-threads" && i + 1 < argc) maxThreads = std::atoi(argv[++i]);
+        else {
+            std::cout << "Usage: chess_smp_bench [--depth N] [--hash MB] [--max-threads N]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::cout << "Lazy SMP bench: " << (sizeof(SUITE) / sizeof(SUITE[0])) << " positions, depth " << depth
+              << ", hash " << hashMb << " MB, " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "time(s)" << std::setw(14) << "nodes"
+              << std::setw(14) << "nps" << std::setw(12) << "ttd-speedup" << std::setw(12) << "nps-scale" << std::endl;
+
+    AI ai((size_t)hashMb, 1);
+    SearchLimits limits;
+    limits.maxDepth = depth;
+    double baseSecs = 0.0, baseNps = 0.0;
+    for (int threads = 1; threads <= 16 && threads <= maxThreads; threads *= 2) {
+        ai.setThreads(threads);
+        double secs = 0.0;
+        uint64_t nodes = 0;
+        for (const char* fen : SUITE) {
+            Position pos;
+            if (!Notation::setFromFEN(pos, fen)) {
+                std::cout << "invalid FEN: " << fen << std::endl;
+                return 1;
+            }
+            ai.clearHash(); // every run starts cold so thread counts compare fairly
+            SearchResult r = ai.think(pos, limits);
+            secs += r.seconds;
+            nodes += r.nodes;
+        }
+        double nps = secs > 0.0 ? nodes / secs : 0.0;
+        if (threads == 1) { baseSecs = secs; baseNps = nps; }
+        std::cout << std::setw(8) << threads << std::setw(12) << std::fixed << std::setprecision(3) << secs
+                  << std::setw(14) << nodes << std::setw(14) << (uint64_t)nps
+                  << std::setw(12) << std::setprecision(2) << (secs > 0.0 ? baseSecs / secs : 0.0)
+                  << std::setw(12) << (baseNps > 0.0 ? nps / baseNps : 0.0) << std::endl;
+    }
+    return 0;
+}
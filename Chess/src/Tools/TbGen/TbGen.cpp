@@ -0,0 +1,52 @@
+// chess_tbgen: retrograde generation of the endgame tablebases (KQK, KRK, KBNK, KPK)
+//
+// Usage: chess_tbgen [--dir <dir>] [--threads N] [--only <name>]
+// Writes "<dir>/<name>.ctb" for every endgame (default dir: current directory) and prints
+// the position counts, longest mate and generation time of each. Tables already in <dir>
+// are loaded first, so "--only KPK" reuses existing KQK/KRK files.
+
+#include "Feature/basic/GameLogic/Tablebase.h"
+#include "threadpool.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::string dir = ".";
+    std::vector<std::string> only;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--dir" && i + 1 < argc) dir = argv[++i];
+        else if (a == "--threads" && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--only" && i + 1 < argc) only.push_back(argv[++i]);
+        else {
+            std::cout << "Usage: chess_tbgen [--dir <dir>] [--threads N] [--only <name>]" << std::endl;
+            return 2;
+        }
+    }
+
+    ThreadPool pool(threads);
+    Tablebase tb;
+    tb.load(dir);
+    std::cout << "generating in " << dir << " on " << pool.size() << " thread(s)" << std::endl;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const std::string& name : only.empty() ? Tablebase::names() : only) {
+        TbGenStats st;
+        std::string error;
+        if (!tb.generate(name, dir, pool, error, &st)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        uint64_t legal = st.wins + st.draws + st.losses;
+        std::cout << name << ": " << legal << " positions (" << st.wins << " won, " << st.draws << " drawn, " << st.losses
+                  << " lost for the side to move), longest mate " << st.maxDtm << " plies, " << st.bits << " bits/entry, "
+                  << (st.entries * st.bits + 7) / 8 / 1024 << " KiB, " << st.seconds << " s" << std::endl;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "total " << secs << " s" << std::endl;
+    return 0;
+}
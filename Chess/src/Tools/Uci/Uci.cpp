@@ -0,0 +1,208 @@
+// chess_uci: UCI front end for the AI search, for GUIs and match runners
+//
+// Usage: chess_uci [--tb <dir>] [--nnue <file>]
+// Speaks UCI on stdin/stdout: uci, isready, ucinewgame, setoption (Hash, Threads, Ponder),
+// position startpos|fen <fen> [moves ...], go (depth, movetime, nodes, infinite, ponder,
+// wtime/btime/winc/binc/movestogo), stop, ponderhit and quit. --tb maps the endgame tables
+// in <dir>, --nnue evaluates with a network file.
+// The search runs on the engine's worker threads and a reporter thread prints bestmove, so
+// the command loop keeps reading while it runs; stop is seen at the next node-count check.
+
+#include "Feature/advanced/AI/AI.h"
+#include "Feature/basic/GameLogic/MoveGen.h"
+#include "Feature/basic/GameLogic/Notation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+static std::mutex outputMutex;
+
+// One protocol line; search threads report too, so lines must not interleave
+static void send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+static std::string scoreToUci(int score) {
+    int mateBound = AI::MATE - 2 * AI::MAX_SEARCH_PLY;
+    if (score >= mateBound) return "mate " + std::to_string((AI::MATE - score + 1) / 2);
+    if (score <= -mateBound) return "mate -" + std::to_string((AI::MATE + score + 1) / 2);
+    return "cp " + std::to_string(score);
+}
+
+static Move parseMove(const Position& pos, const std::string& token) {
+    MoveList moves;
+    MoveGen::generateLegal(pos, moves);
+    for (const Move& m : moves)
+        if (Notation::moveToString(m) == token) return m;
+    return Move();
+}
+
+// position startpos|fen <fen> [moves ...]; false (position unchanged) on a bad FEN or move
+static bool parsePosition(std::istringstream& in, Position& pos, std::string& error) {
+    std::string token, fen;
+    in >> token;
+    if (token == "startpos") {
+        fen = Notation::START_FEN;
+        in >> token;
+    } else if (token == "fen") {
+        while (in >> token && token != "moves") fen += (fen.empty() ? "" : " ") + token;
+    } else {
+        error = "expected startpos or fen";
+        return false;
+    }
+    Position next;
+    if (!Notation::setFromFEN(next, fen)) {
+        error = "invalid FEN: " + fen;
+        return false;
+    }
+    if (token == "moves") {
+        while (in >> token) {
+            Move m = parseMove(next, token);
+            if (m.isNone()) {
+                error = "illegal move " + token;
+                return false;
+            }
+            next.makeMove(m);
+        }
+    }
+    pos = next;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string tbDir, nnuePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--tb" && i + 1 < argc) tbDir = argv[++i];
+        else if (a == "--nnue" && i + 1 < argc) nnuePath = argv[++i];
+        else {
+            std::cout << "Usage: chess_uci [--tb <dir>] [--nnue <file>]" << std::endl;
+            return 2;
+        }
+    }
+
+    // Both outlive the engine, which is declared after them
+    Tablebase tablebase;
+    if (!tbDir.empty()) tablebase.load(tbDir);
+    Nnue nnue;
+    std::string nnueError;
+    bool nnueLoaded = !nnuePath.empty() && nnue.load(nnuePath, nnueError);
+
+    const int defaultHash = 16, maxHash = 4096, maxThreads = 256;
+    AI ai(defaultHash, 1);
+    ai.setTablebase(&tablebase);
+    if (nnueLoaded) ai.setNnue(&nnue);
+    ai.setInfoCallback([&ai](const SearchResult& r) {
+        std::ostringstream info;
+        uint64_t nps = r.seconds > 0.0 ? (uint64_t)(r.nodes / r.seconds) : 0;
+        info << "info depth " << r.depth << " score " << scoreToUci(r.score) << " nodes " << r.nodes << " nps " << nps
+             << " hashfull " << ai.hashfull() << " time " << (uint64_t)(r.seconds * 1000.0) << " pv";
+        for (Move m : r.pv) info << ' ' << Notation::moveToString(m);
+        send(info.str());
+    });
+
+    Position pos;
+    Notation::setFromFEN(pos, Notation::START_FEN);
+
+    // bestmove is printed by the reporter once the search ends; 'go infinite' holds it back
+    // until stop, as the protocol requires
+    std::thread reporter;
+    std::atomic<bool> holdBestMove(false);
+    auto finishSearch = [&]() {
+        if (!reporter.joinable()) return;
+        holdBestMove = false;
+        ai.stop();
+        reporter.join();
+    };
+
+    if (!nnuePath.empty() && !nnueLoaded) send("info string " + nnueError);
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string cmd;
+        in >> cmd;
+        if (cmd == "uci") {
+            send("id name Chess3D");
+            send("id author Chess3D contributors");
+            send("option name Hash type spin default " + std::to_string(defaultHash) + " min 1 max " + std::to_string(maxHash));
+            send("option name Threads type spin default 1 min 1 max " + std::to_string(maxThreads));
+            send("option name Ponder type check default false");
+            send("uciok");
+        } else if (cmd == "isready") {
+            send("readyok");
+        } else if (cmd == "ucinewgame") {
+            finishSearch();
+            ai.clearHash();
+        } else if (cmd == "setoption") {
+            finishSearch();
+            std::string token, name, value;
+            in >> token; // "name"
+            while (in >> token && token != "value") name += (name.empty() ? "" : " ") + token;
+            in >> value;
+            if (name == "Hash") ai.setHashSize((size_t)std::min(std::max(std::atoi(value.c_str()), 1), maxHash));
+            else if (name == "Threads") ai.setThreads(std::min(std::max(std::atoi(value.c_str()), 1), maxThreads));
+            // Ponder only tells the engine that it may be asked to; nothing to set
+        } else if (cmd == "position") {
+            finishSearch();
+            std::string error;
+            if (!parsePosition(in, pos, error)) send("info string " + error);
+        } else if (cmd == "go") {
+            finishSearch();
+            SearchLimits limits;
+            bool infinite = false, ponder = false;
+            int time[2] = { 0, 0 }, inc[2] = { 0, 0 }, movesToGo = 0;
+            std::string token;
+            while (in >> token) {
+                if (token == "depth") in >> limits.maxDepth;
+                else if (token == "movetime") in >> limits.timeMs;
+                else if (token == "nodes") in >> limits.nodes;
+                else if (token == "infinite") infinite = true;
+                else if (token == "ponder") ponder = true;
+                else if (token == "wtime") in >> time[0];
+                else if (token == "btime") in >> time[1];
+                else if (token == "winc") in >> inc[0];
+                else if (token == "binc") in >> inc[1];
+                else if (token == "movestogo") in >> movesToGo;
+            }
+            int side = pos.whiteToMove() ? 0 : 1;
+            if (!limits.timeMs && time[side] > 0) limits.timeMs = AI::allocateTime(time[side], inc[side], movesToGo);
+            if (infinite) limits.timeMs = 0;
+            holdBestMove = infinite;
+            if (ponder) ai.ponder(pos, limits);
+            else ai.start(pos, limits);
+            reporter = std::thread([&ai, &holdBestMove]() {
+                // The reporter is the only thread that polls (and so joins the worker) while it
+                // lives; a search ended without a result still gets its bestmove (0000)
+                SearchResult r;
+                while (!ai.poll(r)) {
+                    if (!ai.isThinking()) break;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                while (holdBestMove) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                std::string out = "bestmove " + Notation::moveToString(r.bestMove);
+                if (!r.ponderMove.isNone()) out += " ponder " + Notation::moveToString(r.ponderMove);
+                send(out);
+            });
+        } else if (cmd == "stop") {
+            finishSearch();
+        } else if (cmd == "ponderhit") {
+            // The pondered position is the one given with 'go ponder'. ponderHit only sets
+            // flags, so it is safe next to the reporter; anything that cancels the search
+            // (setoption, ucinewgame, position) ends the reporter first
+            ai.ponderHit(pos);
+        } else if (cmd == "quit") {
+            break;
+        } else if (!cmd.empty()) {
+            send("info string unknown command " + cmd);
+        }
+    }
+    finishSearch();
+    return 0;
+}
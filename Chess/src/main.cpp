@@ -11,10 +11,16 @@
 #include "Feature/basic/LoadModel/LoadModel.h"
 #include "Feature/basic/CameraControl/CameraControl.h"
 #include "Feature/basic/GameLogic/GameLogic.h"
+#include "Feature/basic/GameLogic/BoardSync.h"
 #include "Feature/basic/MoveObject/MoveObject.h"
 #include "Feature/basic/Texture/Texture.h"
 #include "Feature/basic/Cubemap/Cubemap.h"
 #include "Feature/advanced/Shadow/Shadow.h"
+#include "Feature/advanced/AI/AI.h"
+#include "Feature/advanced/Book/PolyglotBook.h"
+#include "Feature/advanced/Nnue/Nnue.h"
+#include "Feature/basic/GameLogic/Notation.h"
+#include "Feature/basic/GameLogic/Tablebase.h"
 #include "Feature/intermediate/Billboarding/Billboarding.h"
 
 #include <iostream>
@@ -26,23 +32,30 @@ float lightMoveSpeed = 0.1f;
 #include <string>
 #include <vector>
 #include <cmath>
+#include <random>
 
 // Forward declare ChessSquare before globals that use it
 
 #ifndef PATH_TO_OBJECTS
 #define PATH_TO_OBJECTS ""
 #endif
+#ifndef PATH_TO_SRC
+#define PATH_TO_SRC ""
+#endif
 
 static int WINDOW_WIDTH = 1000;
 static int WINDOW_HEIGHT = 700;
 
 Camera camera(glm::vec3(0.0f, 1.5f, 5.0f));
 bool boardFlipped = true;  // Start flipped so initial/top/diagonal face the intended side
-bool whitesTurn = true;    // Start with white to move
 bool colorsFlipped = false; // keep fixed (no toggling)
 bool invertPieceColorsOnce = true; // flip mapping once at startup only
 // Diagnostics/toggles
 bool computeAllowDuringShift = false; // if false, allowable moves are computed only on SHIFT release
+// AI opponent (toggled with P; it takes the side that is not to move at that moment)
+bool aiEnabled = false;
+bool aiPlaysWhite = false;
+static const int AI_THINK_TIME_MS = 1500;
 
 // Track last moved piece per side (index) and its cursor square
 int savedSelWhite = -1; ChessSquare savedCursorWhite; 
@@ -337,6 +350,10 @@ int main() {
     placeBackRank(0, true); placePawns(1, true);
     // Black rows on far side
     placePawns(6, false); placeBackRank(7, false);
+    // Rules state of the game (side to move, castling, en passant, counters); the pieces
+    // vector is only the scene and is synced from it after every move
+    Position game;
+    BoardSync::buildPosition(pieces, game);
     // Start selection/highlight at a2 (white pawn)
     ChessSquare startA2(0,1);
     int selectedPiece = GameLogic::squareToPieceIndex(startA2);
@@ -375,25 +392,53 @@ int main() {
         p.model = glm::scale(m, glm::vec3(scale));
     };
 
-    // Helper: capture enemy piece at target square if present (excluding self index). Returns captured index or -1
-    auto captureIfEnemyAt = [&](int targetFile, int targetRank, int selfIndex)->int {
-        for (int i = 0; i < (int)pieces.size(); ++i) {
-            if (i == selfIndex) continue;
-            if (pieces[i].file == targetFile && pieces[i].rank == targetRank && pieces[i].isWhite != pieces[selfIndex].isWhite) {
-                GameLogic::markCaptured(pieces, i);
-                return i;
+    // Endgame tablebases for the AI and adjudication, mapped if present; chess_tbgen builds them
+    Tablebase tablebase;
+    {
+        const std::string tbDir = PATH_TO_SRC "/Feature/basic/GameLogic/tb";
+        tablebase.load(tbDir);
+        std::cout << "Tablebases: " << tablebase.tableCount() << " of " << Tablebase::names().size() << " loaded";
+        if (tablebase.tableCount() < (int)Tablebase::names().size())
+            std::cout << " (run chess_tbgen --dir " << tbDir << " to build the rest)";
+        std::cout << std::endl;
+    }
+
+    // Rules status (check flags, mate, stalemate, legal destinations per square). Rebuilt lazily
+    // after a move commits (the only place the game Position changes).
+    GameStatus gameStatus;
+    bool gameStatusDirty = true;
+    auto currentStatus = [&]() -> const GameStatus& {
+        if (gameStatusDirty) {
+            GameLogic::computeStatus(game, gameStatus, &tablebase);
+            gameStatusDirty = false;
+            if (gameStatus.whiteCheckmate) std::cout << "CHECKMATE: Black wins! White king is checkmated." << std::endl;
+            else if (gameStatus.blackCheckmate) std::cout << "CHECKMATE: White wins! Black king is checkmated." << std::endl;
+            else if (gameStatus.stalemate) std::cout << "STALEMATE: Side to move has no legal moves." << std::endl;
+            else if (gameStatus.tablebaseHit) {
+                // Adjudication: the exact result with best play from here
+                const char* mover = game.whiteToMove() ? "White" : "Black";
+                const char* other = game.whiteToMove() ? "Black" : "White";
+                const TbResult& r = gameStatus.tablebase;
+                if (r.wdl == TbWdl::DRAW) std::cout << "TABLEBASE: Draw with best play." << std::endl;
+                else std::cout << "TABLEBASE: " << (r.wdl == TbWdl::WIN ? mover : other) << " mates in "
+                               << (r.dtm + 1) / 2 << " with best play." << std::endl;
             }
         }
-        return -1;
+        return gameStatus;
+    };
+    // Legal destination set of the selected piece (empty if nothing valid is selected)
+    auto selectedTargets = [&]() -> Bitboard {
+        if (selectedPiece < 0 || selectedPiece >= (int)pieces.size()) return 0;
+        return currentStatus().targetsFrom(pieces[selectedPiece].file, pieces[selectedPiece].rank);
     };
 
-    // Helper: after move, flip board orientation, optionally colors, set side to move, and restore selection
-    auto finishTurnAndRestoreSelection = [&](bool movedWasWhite, bool flipColors){
+    // Helper: after move, flip board orientation, optionally colors, and restore the selection of the side to move
+    auto finishTurnAndRestoreSelection = [&](bool flipColors){
+        gameStatusDirty = true;
         boardFlipped = !boardFlipped;
         if (flipColors) colorsFlipped = !colorsFlipped;
         CameraControl::setCameraMode(camera, CameraControl::getCurrentCameraMode(), boardFlipped);
-        whitesTurn = !movedWasWhite;
-        if (whitesTurn) {
+        if (game.whiteToMove()) {
             if (savedSelWhite >= 0) { selectedPiece = savedSelWhite; cursorPos = savedCursorWhite; }
             else { selectedPiece = GameLogic::squareToPieceIndex(ChessSquare(0,1)); cursorPos = ChessSquare(0,1); }
         } else {
@@ -402,6 +447,43 @@ int main() {
         }
     };
 
+    // Helper: play a move on the game Position and mirror it onto the scene. The Position
+    // resolves captures, the castling rook, en passant and promotion; the pieces follow it.
+    // Shared by SHIFT release, click-to-move and the AI; returns false for an illegal move.
+    auto commitMove = [&](ChessSquare start, ChessSquare target, PieceType promotion, bool flipColors) -> bool {
+        Move m = currentStatus().findMove(start.file, start.rank, target.file, target.rank, promotion);
+        if (m.isNone()) return false;
+        game.makeMove(m);
+        BoardSync::syncPieces(game, pieces);
+        for (Piece& p : pieces) {
+            if (!GameLogic::isValidSquare(p.file, p.rank)) continue;
+            p.mesh = LoadModel::getMeshFor(p.type); // promotions swap the mesh
+            updatePieceModel(p);
+        }
+        if (m.kind() == MoveKind::PROMOTION)
+            std::cout << "Pawn promoted at (" << target.file << ", " << target.rank << ")" << std::endl;
+        finishTurnAndRestoreSelection(flipColors);
+        return true;
+    };
+
+    // Optional neural evaluation; the hand-written evaluation is used without a network file.
+    // Declared before the engine so it outlives any search still running at exit
+    Nnue nnue;
+    std::string nnueError;
+    bool nnueLoaded = nnue.load(PATH_TO_SRC "/Feature/advanced/Nnue/network.nnue", nnueError);
+    // Engine for the AI opponent; searches run off the render thread (Lazy SMP on spare cores)
+    AI ai(16, AI::defaultThreadCount());
+    ai.setTablebase(&tablebase);
+    if (nnueLoaded) {
+        ai.setNnue(&nnue);
+        std::cout << "NNUE evaluation (" << Nnue::kernelName(Nnue::kernel()) << " kernels)" << std::endl;
+    }
+    // Opening book for the AI and the book hint (B); mapped only, nothing is read until probed
+    PolyglotBook book;
+    if (book.open(PATH_TO_SRC "/Feature/advanced/Book/book.bin"))
+        std::cout << "Opening book: " << book.size() << " entries" << std::endl;
+    std::mt19937_64 bookRng(std::random_device{}());
+
     // Axis geometry (lines)
     GLuint axisVAO=0, axisVBO=0;
     {
@@ -494,86 +576,71 @@ int main() {
             }
         }
 
-        // Compute moves; if side to move is in check, restrict to only legal moves that resolve check
-        std::vector<ChessSquare> allowableMoves;
-        if (selectedPiece >= 0 && selectedPiece < (int)pieces.size()) {
-            bool inCheck = GameLogic::isSideInCheck(pieces, whitesTurn);
-            if (inCheck && pieces[selectedPiece].isWhite == whitesTurn) {
-                allowableMoves = GameLogic::getLegalMovesConsideringCheck(selectedPiece, pieces);
-            } else {
-                allowableMoves = GameLogic::getAllowableMoves(selectedPiece, pieces);
-                // Even when not in check, we should not allow moves that expose king; filter
-                ChessSquare from(pieces[selectedPiece].file, pieces[selectedPiece].rank);
-                allowableMoves.erase(
-                    std::remove_if(allowableMoves.begin(), allowableMoves.end(),
-                        [&](const ChessSquare& m) {
-                            return !GameLogic::wouldBeLegalMove(pieces, selectedPiece, from, m, GameLogic::enPassantAvailable, GameLogic::enPassantSquare);
-                        }),
-                    allowableMoves.end()
-                );
+        // Toggle: AI opponent (P)
+        static bool pressedP = false;
+        bool pk = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+        if (pk && !pressedP) {
+            aiEnabled = !aiEnabled;
+            aiPlaysWhite = !game.whiteToMove();
+            if (!aiEnabled) ai.cancel();
+            std::cout << "AI opponent " << (aiEnabled ? (aiPlaysWhite ? "ON (plays White)" : "ON (plays Black)") : "OFF") << std::endl;
+        }
+        pressedP = pk;
+
+        // AI turn: start a background search, then commit its move once the worker is done
+        bool aiTurn = aiEnabled && game.whiteToMove() == aiPlaysWhite;
+        if (aiTurn) {
+            // The human has replied: a ponder search on the predicted move carries on, any other reply restarts
+            if (ai.ponderHit(game)) std::cout << "AI ponder hit" << std::endl;
+            SearchResult aiResult;
+            if (ai.poll(aiResult)) {
+                Move m = aiResult.bestMove;
+                if (!m.isNone() && commitMove(ChessSquare(fileOf(m.from()), rankOf(m.from())), ChessSquare(fileOf(m.to()), rankOf(m.to())),
+                                              m.kind() == MoveKind::PROMOTION ? m.promotion() : PieceType::QUEEN, false)) {
+                    std::cout << "AI plays " << Notation::moveToString(m) << " (depth " << aiResult.depth << ", score "
+                              << aiResult.score << ", " << aiResult.nodes << " nodes)" << std::endl;
+                    // Ponder on the expected reply while the human thinks
+                    if (!aiResult.ponderMove.isNone()) {
+                        Position predicted = game;
+                        predicted.makeMove(aiResult.ponderMove);
+                        SearchLimits limits;
+                        limits.timeMs = AI_THINK_TIME_MS;
+                        ai.ponder(predicted, limits);
+                        std::cout << "AI ponders on " << Notation::moveToString(aiResult.ponderMove) << std::endl;
+                    }
+                } else {
+                    std::cout << "AI has no legal move; AI opponent OFF" << std::endl;
+                    aiEnabled = false;
+                }
+            } else if (!ai.isThinking()) {
+                // Book moves are played instantly; the search only starts once out of book
+                Move bm = book.isOpen() ? book.pick(game, bookRng()) : Move();
+                std::string san = bm.isNone() ? "" : Notation::moveToSAN(game, bm);
+                if (!bm.isNone() && commitMove(ChessSquare(fileOf(bm.from()), rankOf(bm.from())), ChessSquare(fileOf(bm.to()), rankOf(bm.to())),
+                                               bm.kind() == MoveKind::PROMOTION ? bm.promotion() : PieceType::QUEEN, false)) {
+                    std::cout << "AI plays " << san << " (book)" << std::endl;
+                } else {
+                    SearchLimits limits;
+                    limits.timeMs = AI_THINK_TIME_MS;
+                    ai.start(game, limits);
+                }
             }
         }
 
+        // Compute legal moves of the selected piece (check evasions and pins handled by the generator)
+        Bitboard allowableTargets = selectedTargets();
+
         // Pending target while SHIFT is held
         if (shift) {
             MoveObject::handleShiftMovement(window, boardFlipped, pendingTarget, hasPendingTarget, pendingStart, accumDx, accumDy, pieces, selectedPiece);
         } else {
             // SHIFT released: validate only final pendingTarget
-            if (MoveObject::getPrevShift() && hasPendingTarget && selectedPiece >= 0 && selectedPiece < (int)pieces.size()) {
+            if (MoveObject::getPrevShift() && hasPendingTarget && !aiTurn && selectedPiece >= 0 && selectedPiece < (int)pieces.size()) {
                 if (!(pendingTarget.file == pendingStart.file && pendingTarget.rank == pendingStart.rank)) {
-                    if (GameLogic::canCommitMove(pieces, selectedPiece, pendingStart, pendingTarget, whitesTurn)) {
+                    if (!currentStatus().findMove(pendingStart.file, pendingStart.rank, pendingTarget.file, pendingTarget.rank).isNone()) {
                         std::cout << "SHIFT release: start=(" << pendingStart.file << "," << pendingStart.rank << ") final=(" 
                                   << pendingTarget.file << "," << pendingTarget.rank << ") allowed=yes" << std::endl;
-                        // Handle capture if enemy present
-                        captureIfEnemyAt(pendingTarget.file, pendingTarget.rank, selectedPiece);
-                        bool movingWasWhite = pieces[selectedPiece].isWhite;
-                        // Commit move
-                        // Castling rook move if king moved two squares
-                        if (pieces[selectedPiece].type == PieceType::KING && abs(pendingTarget.file - pendingStart.file) == 2) {
-                            int rr = pendingStart.rank;
-                            if (pendingTarget.file > pendingStart.file) {
-                                // king side: move rook from 7 to 5
-                                for (int i=0;i<(int)pieces.size();++i) if (pieces[i].type==PieceType::ROOK && pieces[i].isWhite==movingWasWhite && pieces[i].rank==rr && pieces[i].file==7) {
-                                    pieces[i].file = 5; pieces[i].hasMoved = true;
-                                    updatePieceModel(pieces[i]);
-                                    break;
-                                }
-                            } else {
-                                // queen side: move rook from 0 to 3
-                                for (int i=0;i<(int)pieces.size();++i) if (pieces[i].type==PieceType::ROOK && pieces[i].isWhite==movingWasWhite && pieces[i].rank==rr && pieces[i].file==0) {
-                                    pieces[i].file = 3; pieces[i].hasMoved = true;
-                                    updatePieceModel(pieces[i]);
-                                    break;
-                                }
-                            }
-                        }
-                        // En-passant capture if pawn moved to enPassantSquare
-                        if (pieces[selectedPiece].type == PieceType::PAWN && GameLogic::enPassantAvailable && pendingTarget.file == GameLogic::enPassantSquare.file && pendingTarget.rank == GameLogic::enPassantSquare.rank) {
-                            int dir = movingWasWhite ? 1 : -1;
-                            int victimRank = pendingTarget.rank - dir;
-                            for (int i=0;i<(int)pieces.size();++i) if (pieces[i].file==pendingTarget.file && pieces[i].rank==victimRank && pieces[i].type==PieceType::PAWN && pieces[i].isWhite!=movingWasWhite) { GameLogic::markCaptured(pieces, i); break; }
-                        }
-                        // Update piece
-                        pieces[selectedPiece].file = pendingTarget.file;
-                        pieces[selectedPiece].rank = pendingTarget.rank;
-                        pieces[selectedPiece].hasMoved = true;
-                        updatePieceModel(pieces[selectedPiece]);
-                        // Pawn promotion (auto-queen)
-                        if (pieces[selectedPiece].type == PieceType::PAWN && ((movingWasWhite && pieces[selectedPiece].rank == 7) || (!movingWasWhite && pieces[selectedPiece].rank == 0))) {
-                            pieces[selectedPiece].type = PieceType::QUEEN;
-                            // Update the mesh to reflect the new piece type
-                            pieces[selectedPiece].mesh = LoadModel::getMeshFor(PieceType::QUEEN);
-                            // Update model scale for new type
-                            updatePieceModel(pieces[selectedPiece]);
-                            std::cout << "Pawn promoted to Queen at (" << pieces[selectedPiece].file << ", " << pieces[selectedPiece].rank << ")" << std::endl;
-                        }
-                        // Update en-passant availability for next move
-                        GameLogic::enPassantAvailable = false; GameLogic::enPassantVictimIndex = -1;
-                        if (pieces[selectedPiece].type == PieceType::PAWN && abs(pendingTarget.rank - pendingStart.rank) == 2) {
-                            GameLogic::enPassantAvailable = true; GameLogic::enPassantVictimIndex = selectedPiece; GameLogic::enPassantSquare = ChessSquare(pendingStart.file, (pendingStart.rank + pendingTarget.rank)/2);
-                        }
-                        // Finish turn (no color flip here)
-                        finishTurnAndRestoreSelection(movingWasWhite, false);
+                        commitMove(pendingStart, pendingTarget, PieceType::QUEEN, false);
                     }
                 }
             }
@@ -582,7 +649,7 @@ int main() {
             // Normal cursor navigation when SHIFT is not held (selection can browse any side)
             int dx = 0, dy = 0;
             if (MoveObject::checkArrowKeyEdge(window, dx, dy, boardFlipped)) {
-                MoveObject::updateCursorPosition(cursorPos, dx, dy, pieces, selectedPiece);
+                MoveObject::updateCursorPosition(cursorPos, dx, dy, game, selectedPiece);
             }
         }
         
@@ -611,6 +678,23 @@ int main() {
         }
         pressedH = hk;
 
+        // Hint: book moves for the side to move (B)
+        static bool pressedB = false;
+        bool bk = glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS;
+        if (bk && !pressedB) {
+            std::vector<BookMove> hints = book.isOpen() ? book.probe(game) : std::vector<BookMove>();
+            if (hints.empty()) std::cout << "Book: no moves for this position" << std::endl;
+            else {
+                unsigned total = 0;
+                for (const BookMove& b : hints) total += b.weight;
+                std::cout << "Book:";
+                for (const BookMove& b : hints)
+                    std::cout << " " << Notation::moveToSAN(game, b.move) << " (" << (total ? 100 * b.weight / total : 0) << "%)";
+                std::cout << std::endl;
+            }
+        }
+        pressedB = bk;
+
         // Handle chess notation input and camera modes
         static bool pressedTab = false;
         bool tab = glfwGetKey(window, GLFW_KEY_TAB) == GLFW_PRESS;
@@ -683,8 +767,8 @@ int main() {
             clickPending = false;
             if (selectedPiece >= 0 && selectedPiece < (int)pieces.size()) {
                 const Piece& sel = pieces[selectedPiece];
-                // Only allow if respect turn
-                if (sel.isWhite == whitesTurn) {
+                // Only allow if respect turn (and never on the AI's turn)
+                if (sel.isWhite == game.whiteToMove() && !aiTurn) {
                     float xNdc = (float)((2.0 * clickX) / WINDOW_WIDTH - 1.0);
                     float yNdc = (float)(1.0 - (2.0 * clickY) / WINDOW_HEIGHT);
                     glm::vec4 rayClip(xNdc, yNdc, -1.0f, 1.0f);
@@ -702,21 +786,14 @@ int main() {
                             int rank = (int)roundf(hit.z / 0.6f + 3.5f);
                             file = glm::clamp(file, 0, 7); rank = glm::clamp(rank, 0, 7);
                             // Always require the target to be within the legal set considering checks and king safety
-                            bool allowed = false;
-                            {
-                                std::vector<ChessSquare> moves = GameLogic::getLegalMovesConsideringCheck(selectedPiece, pieces);
-                                for (const auto& m : moves) if (m.file == file && m.rank == rank) { allowed = true; break; }
-                            }
+                            bool allowed = (selectedTargets() & squareBB(squareOf(file, rank))) != 0;
                             if (allowed) {
-                                // Capture if enemy on target (robust)
-                                captureIfEnemyAt(file, rank, selectedPiece);
-                                pieces[selectedPiece].file = file; pieces[selectedPiece].rank = rank;
-                                updatePieceModel(pieces[selectedPiece]);
+                                ChessSquare from(sel.file, sel.rank);
                                 cursorPos = ChessSquare(file, rank);
                                 if (sel.isWhite) { savedSelWhite = selectedPiece; savedCursorWhite = cursorPos; }
                                 else { savedSelBlack = selectedPiece; savedCursorBlack = cursorPos; }
-                                // Finish turn and also flip colors for click-to-move path
-                                finishTurnAndRestoreSelection(sel.isWhite, true);
+                                // Commit and also flip colors for click-to-move path
+                                commitMove(from, cursorPos, PieceType::QUEEN, true);
                             }
                         }
                     }
@@ -750,36 +827,38 @@ int main() {
 
         // Conditionally compute allowable moves for visual hints
         if (computeAllowDuringShift) {
-            if (selectedPiece >= 0 && selectedPiece < pieces.size()) {
-                allowableMoves = GameLogic::getLegalMovesConsideringCheck(selectedPiece, pieces);
-            }
+            allowableTargets = selectedTargets();
         } else {
-            allowableMoves.clear();
+            allowableTargets = 0;
         }
         for(size_t i=0;i<tileModels.size();++i){
             int tileFile = i % 8; int tileRank = i / 8;
-            bool isSelectedSquare = false, isAllowableMove = false, isPending = false, isCapture = false;
+            bool isSelectedSquare = false, isAllowableMove = false, isPending = false;
+            CaptureKind capture = CaptureKind::NONE;
             if (selectedPiece < 0 || selectedPiece >= pieces.size()) {
                 if (tileFile == cursorPos.file && tileRank == cursorPos.rank) isSelectedSquare = true;
             } else {
-                bool squareHasPiece = false; int occupant = -1;
-                for(size_t j=0;j<pieces.size();++j) {
-                    if (pieces[j].file == tileFile && pieces[j].rank == tileRank) { squareHasPiece = true; occupant = (int)j; break; }
-                }
+                bool squareHasPiece = !game.isEmpty(squareOf(tileFile, tileRank));
                 if (!squareHasPiece && tileFile == cursorPos.file && tileRank == cursorPos.rank) isSelectedSquare = true;
-                for (const auto& move : allowableMoves) if (move.file == tileFile && move.rank == tileRank) { isAllowableMove = true; break; }
-                // If this allowable square has an enemy on it, mark as capture candidate when pressing SHIFT
-                if (isAllowableMove && shift && occupant >= 0 && pieces[occupant].isWhite != pieces[selectedPiece].isWhite) {
-                    isCapture = true;
+                isAllowableMove = (allowableTargets & squareBB(squareOf(tileFile, tileRank))) != 0;
+                // While SHIFT is held, captures are shaded by their exchange outcome (SEE)
+                if (isAllowableMove && shift) {
+                    capture = currentStatus().captureKind(pieces[selectedPiece].file, pieces[selectedPiece].rank, tileFile, tileRank);
                 }
             }
             if (hasPendingTarget && tileFile == pendingTarget.file && tileRank == pendingTarget.rank) isPending = true;
             if (isPending) {
                 shadowReceiverSh.setBool("useTexture", false);
                 shadowReceiverSh.setVector3f("baseCol", glm::vec3(0.0f, 0.8f, 0.2f)); // green pending
-            } else if (isCapture) {
+            } else if (capture == CaptureKind::WINNING) {
                 shadowReceiverSh.setBool("useTexture", false);
-                shadowReceiverSh.setVector3f("baseCol", glm::vec3(0.1f, 0.45f, 1.0f)); // blue capture
+                shadowReceiverSh.setVector3f("baseCol", glm::vec3(0.1f, 0.45f, 1.0f)); // blue winning capture
+            } else if (capture == CaptureKind::EQUAL) {
+                shadowReceiverSh.setBool("useTexture", false);
+                shadowReceiverSh.setVector3f("baseCol", glm::vec3(1.0f, 0.85f, 0.1f)); // yellow even trade
+            } else if (capture == CaptureKind::LOSING) {
+                shadowReceiverSh.setBool("useTexture", false);
+                shadowReceiverSh.setVector3f("baseCol", glm::vec3(0.75f, 0.1f, 0.75f)); // magenta losing capture
             } else if (isAllowableMove) {
                 shadowReceiverSh.setBool("useTexture", false);
                 shadowReceiverSh.setVector3f("baseCol", glm::vec3(1.0f, 0.5f, 0.0f)); // orange
@@ -810,9 +889,9 @@ int main() {
 
         // King-in-check halo overlays: draw a red tile under the king(s) in check
         auto drawCheckHalo = [&](bool whiteKing){
-            int k = GameLogic::findKingIndex(pieces, whiteKing);
+            if (!(whiteKing ? currentStatus().whiteInCheck : currentStatus().blackInCheck)) return;
+            int k = BoardSync::findKingIndex(pieces, whiteKing);
             if (k < 0) return;
-            if (!GameLogic::isSquareAttacked(pieces, pieces[k].file, pieces[k].rank, !whiteKing)) return;
             glm::mat4 halo = glm::translate(glm::mat4(1.0f), glm::vec3((pieces[k].file-3.5f)*0.6f, TILE_Y + 0.001f, (pieces[k].rank-3.5f)*0.6f));
             halo = glm::scale(halo, glm::vec3(0.6f, 1.0f, 0.6f));
             shadowReceiverSh.setBool("useTexture", false);
@@ -836,9 +915,10 @@ int main() {
             }
         }
         
-        // Check for checkmate/stalemate and display messages
-        bool whiteInCheck = GameLogic::isSideInCheck(pieces, true);
-        bool blackInCheck = GameLogic::isSideInCheck(pieces, false);
+        // Check for checkmate/stalemate and display messages (cached until the next move)
+        const GameStatus& status = currentStatus();
+        bool whiteInCheck = status.whiteInCheck;
+        bool blackInCheck = status.blackInCheck;
         
         // Debug: Print check status
         static bool lastWhiteInCheck = false, lastBlackInCheck = false;
@@ -852,64 +932,7 @@ int main() {
             else std::cout << "Black king is no longer in check." << std::endl;
             lastBlackInCheck = blackInCheck;
         }
-        
-        // Debug: Check for checkmate and stalemate
-        bool whiteCheckmate = false, blackCheckmate = false, stalemate = false;
-        
-        // Check for checkmate
-        if (whiteInCheck) {
-            // Check if white has any legal moves
-            bool whiteHasLegalMoves = false;
-            for (size_t i = 0; i < pieces.size(); ++i) {
-                if (pieces[i].isWhite && pieces[i].file >= 0 && pieces[i].rank >= 0) {
-                    auto moves = GameLogic::getLegalMovesConsideringCheck(i, pieces);
-                    if (!moves.empty()) {
-                        whiteHasLegalMoves = true;
-                        break;
-                    }
-                }
-            }
-            if (!whiteHasLegalMoves) {
-                whiteCheckmate = true;
-                std::cout << "CHECKMATE: Black wins! White king is checkmated." << std::endl;
-            }
-        }
-        
-        if (blackInCheck) {
-            // Check if black has any legal moves
-            bool blackHasLegalMoves = false;
-            for (size_t i = 0; i < pieces.size(); ++i) {
-                if (!pieces[i].isWhite && pieces[i].file >= 0 && pieces[i].rank >= 0) {
-                    auto moves = GameLogic::getLegalMovesConsideringCheck(i, pieces);
-                    if (!moves.empty()) {
-                        blackHasLegalMoves = true;
-                        break;
-                    }
-                }
-            }
-            if (!blackHasLegalMoves) {
-                blackCheckmate = true;
-                std::cout << "CHECKMATE: White wins! Black king is checkmated." << std::endl;
-            }
-        }
-        
-        // Check for stalemate (side to move has no legal moves and is NOT in check)
-        if (!whiteCheckmate && !blackCheckmate) {
-            bool sideInCheck = whitesTurn ? whiteInCheck : blackInCheck;
-            if (!sideInCheck) {
-                bool sideHasMoves = false;
-                for (size_t i = 0; i < pieces.size(); ++i) {
-                    if (pieces[i].isWhite == whitesTurn && pieces[i].file >= 0 && pieces[i].rank >= 0) {
-                        auto moves = GameLogic::getLegalMovesConsideringCheck(i, pieces);
-                        if (!moves.empty()) { sideHasMoves = true; break; }
-                    }
-                }
-                if (!sideHasMoves) {
-                    stalemate = true;
-                    std::cout << "STALEMATE: Side to move has no legal moves." << std::endl;
-                }
-            }
-        }
+        bool whiteCheckmate = status.whiteCheckmate, blackCheckmate = status.blackCheckmate, stalemate = status.stalemate;
         
         // Remove old check messages
         static int checkMessageIndex = -1;
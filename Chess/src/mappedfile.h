@@ -0,0 +1,129 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only mapping of one window of a file at a time, so the headless tools can stream
+// files far larger than memory: only the current window occupies address space, and its
+// clean pages can be dropped by the OS at any time
+class MappedFile {
+public:
+    MappedFile() {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz)) { close(); return false; }
+        fileSize = (uint64_t)sz.QuadPart;
+        if (fileSize && !(mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))) { close(); return false; }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(); return false; }
+        fileSize = (uint64_t)st.st_size;
+#endif
+        return true;
+    }
+
+    void close() {
+        unmap();
+#ifdef _WIN32
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        fileSize = 0;
+    }
+
+    uint64_t size() const { return fileSize; }
+
+    // Map [offset, offset + length), clamped to the end of the file; the previous window is
+    // released. data() points at 'offset' even though the OS maps from an aligned boundary.
+    // 'sequential' tunes read-ahead for streaming; pass false for scattered lookups
+    bool map(uint64_t offset, size_t length, bool sequential = true) {
+        unmap();
+        if (offset >= fileSize) return false;
+        if (length > fileSize - offset) length = (size_t)(fileSize - offset);
+        uint64_t base = offset - offset % granularity();
+        size_t span = (size_t)(offset - base) + length;
+#ifdef _WIN32
+        void* p = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(base >> 32), (DWORD)base, span);
+        if (!p) return false;
+#else
+        void* p = mmap(nullptr, span, PROT_READ, MAP_PRIVATE, fd, (off_t)base);
+        if (p == MAP_FAILED) return false;
+        madvise(p, span, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#endif
+        view = p;
+        viewSize = span;
+        window = (const char*)p + (offset - base);
+        windowSize = length;
+        return true;
+    }
+
+    void unmap() {
+        if (!view) return;
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+#else
+        munmap(view, viewSize);
+#endif
+        view = nullptr;
+        window = nullptr;
+        viewSize = windowSize = 0;
+    }
+
+    const char* data() const { return window; }
+    size_t length() const { return windowSize; }
+
+    // Mapping offsets are rounded down to this
+    static uint64_t granularity() {
+#ifdef _WIN32
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return si.dwAllocationGranularity;
+#else
+        return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    uint64_t fileSize = 0;
+    void* view = nullptr;
+    size_t viewSize = 0;
+    const char* window = nullptr;
+    size_t windowSize = 0;
+};
+#endif
@@ -0,0 +1,67 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool for the headless tools (perft, batch analysis)
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount = 0) {
+        if (threadCount == 0) threadCount = defaultThreadCount();
+        for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back([this]{ workerLoop(); });
+    }
+    ~ThreadPool() {
+        { std::lock_guard<std::mutex> lock(mtx); stopping = true; }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> task) {
+        { std::lock_guard<std::mutex> lock(mtx); tasks.push(std::move(task)); ++pending; }
+        wake.notify_one();
+    }
+    // Block until every queued task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        idle.wait(lock, [this]{ return pending == 0; });
+    }
+    unsigned size() const { return (unsigned)workers.size(); }
+
+    static unsigned defaultThreadCount() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                wake.wait(lock, [this]{ return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front()); tasks.pop();
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (--pending == 0) idle.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable wake, idle;
+    size_t pending = 0;
+    bool stopping = false;
+};
+#endif